@@ -0,0 +1,482 @@
+#include <atomic>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <seqan3/alphabet/nucleotide/dna4.hpp>
+#include <seqan3/argument_parser/all.hpp>
+#include <seqan3/io/sequence_file/input.hpp>
+#include <seqan3/search/views/minimiser_hash.hpp>
+#include <seqan3/search/views/minstrobe_hash.hpp>
+#include <seqan3/search/views/opensyncmer_hash.hpp>
+#include <seqan3/search/views/syncmer_hash.hpp>
+
+/* Computes the false positives and false negatives of assigning reads to references by their shared hashes.
+ *
+ * Query file i contains reads sampled from reference file i. A read matches a reference if at least `threshold` of its
+ * hashes are in the hash set of the reference; a read not matching its own reference is a false negative, every match
+ * with another reference is a false positive. The output is the CSV read by src/plot_accuracy.r, one line
+ * "kmer,smer,fp,fn" per (k, s) combination, or "threshold,kmer,smer,fp,fn" if several thresholds are given. Name the
+ * output data_<method>_... so that plot_accuracy.r picks up the method.
+ *
+ * The fraction of matching hashes of every read and reference is recorded in a histogram with resolution
+ * 1 / fraction_bins, the counts of all thresholds are cumulative sums of these histograms.
+ *
+ * For minimiser, kmer is the window size and smer the shape size. For minstrobe, smer is the strobe size and the second
+ * strobe starts between smer and kmer - smer positions after the first, so a minstrobe spans at most kmer characters.
+ */
+
+struct dna4_traits : seqan3::sequence_file_input_default_traits_dna
+{
+    using sequence_alphabet = seqan3::dna4;
+};
+
+using sequence_t = std::vector<seqan3::dna4>;
+
+struct accuracy_arguments
+{
+    std::string method{"syncmer"};
+    std::vector<size_t> kmers{};
+    std::vector<size_t> smers{};
+    std::vector<double> thresholds{};
+    double threshold_step{0.0};
+    std::vector<std::filesystem::path> references{};
+    std::vector<std::filesystem::path> queries{};
+    std::filesystem::path output{};
+    size_t threads{1};
+};
+
+// A read and the index of the reference it was sampled from.
+struct query_t
+{
+    sequence_t sequence;
+    size_t origin;
+};
+
+// The number of histogram bins per unit of matching fraction; thresholds are multiples of 1 / fraction_bins.
+constexpr size_t fraction_bins{1000};
+
+struct accuracy_counts
+{
+    std::vector<size_t> fp{};
+    std::vector<size_t> fn{};
+};
+
+std::vector<sequence_t> read_sequences(std::filesystem::path const & path)
+{
+    std::vector<sequence_t> sequences{};
+    seqan3::sequence_file_input<dna4_traits, seqan3::fields<seqan3::field::seq>> fin{path};
+
+    for (auto & record : fin)
+        sequences.push_back(std::move(record.sequence()));
+
+    return sequences;
+}
+
+// The first histogram bin that matches a threshold.
+size_t threshold_bin(double const threshold)
+{
+    return static_cast<size_t>(std::llround(threshold * fraction_bins));
+}
+
+// Whether the method can be computed for the given k-mer and s-mer size. Syncmers hash whole k-mers, so their k is at
+// most 32 like s; both are only narrowed to a shape size after this check.
+bool valid_parameters(std::string const & method, size_t const kmer, size_t const smer)
+{
+    if (smer == 0 || smer > 32 || smer >= kmer)
+        return false;
+
+    if ((method == "syncmer" || method == "opensyncmer") && kmer > 32)
+        return false;
+
+    if (method == "minstrobe")
+        return smer > 1 && kmer >= 2 * smer;
+
+    return true;
+}
+
+// The seed of the *_hash views.
+constexpr uint64_t default_seed{0x8F3F73B5CF1C9ADE};
+
+// The s-mer hashes of a sequence; computed once per s-mer size and shared by all k-mer sizes.
+struct smer_streams
+{
+    std::vector<uint64_t> forward{};
+    std::vector<uint64_t> reverse{};
+};
+
+// Computes the s-mer hashes of a sequence like the *_hash views, the reverse strand is only needed for minimiser.
+void compute_smers(std::string const & method, size_t const smer, sequence_t const & sequence, smer_streams & streams)
+{
+    streams.forward.clear();
+    streams.reverse.clear();
+    if (sequence.size() < smer)
+        return;
+
+    auto const shape = seqan3::shape{seqan3::ungapped{static_cast<uint8_t>(smer)}};
+    auto const seeded = std::views::transform([] (uint64_t const hash) { return hash ^ default_seed; });
+
+    for (uint64_t const hash : sequence | seqan3::views::kmer_hash(shape) | seeded)
+        streams.forward.push_back(hash);
+
+    if (method == "minimiser")
+    {
+        for (uint64_t const hash : sequence | seqan3::views::complement
+                                            | std::views::reverse
+                                            | seqan3::views::kmer_hash(shape)
+                                            | seeded)
+            streams.reverse.push_back(hash);
+        std::ranges::reverse(streams.reverse);
+    }
+}
+
+// Calls `callback` with every syncmer of the sequence for the offsets `offsets_t`; only syncmers hash whole k-mers.
+template <typename offsets_t, typename smers_t, typename callback_t>
+void for_each_syncmer(size_t const kmer,
+                      size_t const smer,
+                      sequence_t const & sequence,
+                      smers_t smers_hash,
+                      callback_t && callback)
+{
+    auto kmers_hash = sequence | seqan3::views::kmer_hash(seqan3::shape{seqan3::ungapped{static_cast<uint8_t>(kmer)}})
+                               | std::views::transform([] (uint64_t const hash) { return hash ^ default_seed; });
+
+    seqan3::detail::syncmer_view<smers_t, decltype(kmers_hash), offsets_t> syncmers{smers_hash,
+                                                                                     kmers_hash,
+                                                                                     kmer - smer + 1};
+    for (uint64_t const hash : syncmers)
+        callback(hash);
+}
+
+// Calls `callback` with every hash of the method on the sequence, sequences shorter than a k-mer have no hashes.
+// Gives the same hashes as the corresponding *_hash view, but reuses the s-mer hashes of `streams`.
+template <typename callback_t>
+void for_each_hash(std::string const & method,
+                   size_t const kmer,
+                   size_t const smer,
+                   sequence_t const & sequence,
+                   smer_streams const & streams,
+                   callback_t && callback)
+{
+    if (sequence.size() < kmer)
+        return;
+
+    auto smers_hash = std::views::all(streams.forward);
+
+    if (method == "syncmer")
+    {
+        for_each_syncmer<seqan3::closed_syncmer_offsets>(kmer, smer, sequence, smers_hash, callback);
+    }
+    else if (method == "opensyncmer")
+    {
+        for_each_syncmer<seqan3::open_syncmer_offsets>(kmer, smer, sequence, smers_hash, callback);
+    }
+    else if (method == "minimiser")
+    {
+        for (uint64_t const hash : seqan3::detail::minimiser_view(smers_hash,
+                                                                  std::views::all(streams.reverse),
+                                                                  kmer - smer + 1))
+            callback(hash);
+    }
+    else
+    {
+        // A minstrobe consists of the hashes of both strobes.
+        for (auto const & strobes : seqan3::detail::minstrobe_view(smers_hash, smer, kmer - smer))
+            callback(mix_hash(strobes[0]) ^ strobes[1]);
+    }
+}
+
+// Calls `function(i)` for every i in [0, count) on `threads` threads.
+template <typename function_t>
+void parallel_for(size_t const threads, size_t const count, function_t && function)
+{
+    std::atomic<size_t> next{0};
+    auto worker = [&] ()
+    {
+        for (size_t i = next++; i < count; i = next++)
+            function(i);
+    };
+
+    std::vector<std::jthread> workers{};
+    for (size_t thread = 1; thread < threads; ++thread)
+        workers.emplace_back(worker);
+    worker();
+}
+
+// The valid (k, s) combinations, grouped by s-mer size.
+struct parameter_grid
+{
+    std::vector<size_t> smers{};
+    // kmers[i] are the k-mer sizes of smers[i], first[i] is the index of the first of them in the grid.
+    std::vector<std::vector<size_t>> kmers{};
+    std::vector<size_t> first{};
+    size_t size{0};
+
+    size_t index(size_t const smer_index, size_t const kmer_index) const
+    {
+        return first[smer_index] + kmer_index;
+    }
+};
+
+parameter_grid make_grid(accuracy_arguments const & args)
+{
+    parameter_grid grid{};
+
+    for (size_t const smer : args.smers)
+    {
+        std::vector<size_t> kmers{};
+        for (size_t const kmer : args.kmers)
+        {
+            if (valid_parameters(args.method, kmer, smer))
+                kmers.push_back(kmer);
+            else
+                std::cerr << "Skipping kmer " << kmer << " and smer " << smer << ", they are not valid for "
+                          << args.method << ".\n";
+        }
+
+        if (kmers.empty())
+            continue;
+
+        grid.smers.push_back(smer);
+        grid.first.push_back(grid.size);
+        grid.size += kmers.size();
+        grid.kmers.push_back(std::move(kmers));
+    }
+
+    return grid;
+}
+
+/* Evaluates all (k, s) combinations of the grid in one traversal of the input: every sequence is hashed once per
+ * s-mer size and the selection for all k-mer sizes runs on these hashes. The hash sets are built by one task per
+ * (reference, s-mer size), the reads are evaluated in chunks; both are spread over the threads.
+ *
+ * For every grid point, one histogram counts the reads by the fraction of their hashes found in their own reference,
+ * another one the (read, other reference) pairs. A read with `m` of `n` hashes in a reference is in bin
+ * `m * fraction_bins / n` and matches for threshold `t` iff its bin is at least `t * fraction_bins`, so the false
+ * negatives of all thresholds are prefix sums of the first and the false positives suffix sums of the second
+ * histogram. Reads without hashes never match. Returns the counts of each grid point.
+ */
+std::vector<accuracy_counts> sweep(accuracy_arguments const & args,
+                                   parameter_grid const & grid,
+                                   std::vector<std::vector<sequence_t>> const & references,
+                                   std::vector<query_t> const & queries)
+{
+    size_t const reference_count = references.size();
+    size_t const threshold_count = args.thresholds.size();
+    size_t const bin_count = fraction_bins + 1;
+
+    // reference_hashes[point * reference_count + id] is the hash set of reference id for the grid point.
+    std::vector<std::unordered_set<uint64_t>> reference_hashes(grid.size * reference_count);
+    parallel_for(args.threads, grid.smers.size() * reference_count, [&] (size_t const task)
+    {
+        size_t const smer_index = task / reference_count;
+        size_t const id = task % reference_count;
+        smer_streams streams{};
+
+        for (sequence_t const & sequence : references[id])
+        {
+            compute_smers(args.method, grid.smers[smer_index], sequence, streams);
+
+            for (size_t kmer_index = 0; kmer_index < grid.kmers[smer_index].size(); ++kmer_index)
+            {
+                auto & hashes = reference_hashes[grid.index(smer_index, kmer_index) * reference_count + id];
+                for_each_hash(args.method, grid.kmers[smer_index][kmer_index], grid.smers[smer_index], sequence,
+                              streams, [&hashes] (uint64_t const hash) { hashes.insert(hash); });
+            }
+        }
+    });
+
+    // own[point * bin_count + bin] and other[point * bin_count + bin], unmatched[point] counts reads without hashes.
+    std::vector<std::atomic<size_t>> own(grid.size * bin_count);
+    std::vector<std::atomic<size_t>> other(grid.size * bin_count);
+    std::vector<std::atomic<size_t>> unmatched(grid.size);
+    size_t const chunk_size{1024};
+
+    parallel_for(args.threads, (queries.size() + chunk_size - 1) / chunk_size, [&] (size_t const chunk)
+    {
+        smer_streams streams{};
+        std::vector<uint64_t> hashes{};
+        std::vector<size_t> local_own(own.size(), 0);
+        std::vector<size_t> local_other(other.size(), 0);
+        std::vector<size_t> local_unmatched(unmatched.size(), 0);
+
+        for (size_t i = chunk * chunk_size; i < std::min(queries.size(), (chunk + 1) * chunk_size); ++i)
+        {
+            for (size_t smer_index = 0; smer_index < grid.smers.size(); ++smer_index)
+            {
+                compute_smers(args.method, grid.smers[smer_index], queries[i].sequence, streams);
+
+                for (size_t kmer_index = 0; kmer_index < grid.kmers[smer_index].size(); ++kmer_index)
+                {
+                    size_t const point = grid.index(smer_index, kmer_index);
+                    hashes.clear();
+                    for_each_hash(args.method, grid.kmers[smer_index][kmer_index], grid.smers[smer_index],
+                                  queries[i].sequence, streams, [&hashes] (uint64_t const hash)
+                    {
+                        hashes.push_back(hash);
+                    });
+
+                    if (hashes.empty())
+                    {
+                        ++local_unmatched[point];
+                        continue;
+                    }
+
+                    for (size_t id = 0; id < reference_count; ++id)
+                    {
+                        size_t matches{0};
+                        for (uint64_t const hash : hashes)
+                            matches += reference_hashes[point * reference_count + id].contains(hash);
+
+                        size_t const bin = matches * fraction_bins / hashes.size();
+                        if (id == queries[i].origin)
+                            ++local_own[point * bin_count + bin];
+                        else
+                            ++local_other[point * bin_count + bin];
+                    }
+                }
+            }
+        }
+
+        for (size_t i = 0; i < own.size(); ++i)
+        {
+            own[i] += local_own[i];
+            other[i] += local_other[i];
+        }
+        for (size_t i = 0; i < unmatched.size(); ++i)
+            unmatched[i] += local_unmatched[i];
+    });
+
+    std::vector<accuracy_counts> counts(grid.size);
+    for (size_t point = 0; point < grid.size; ++point)
+    {
+        // fn_below[b] is the number of reads whose own bin is smaller than b, fp_from[b] the number of pairs with
+        // another reference whose bin is at least b.
+        std::vector<size_t> fn_below(bin_count + 1, unmatched[point]);
+        std::vector<size_t> fp_from(bin_count + 1, 0);
+        for (size_t bin = 0; bin < bin_count; ++bin)
+            fn_below[bin + 1] = fn_below[bin] + own[point * bin_count + bin];
+        for (size_t bin = bin_count; bin > 0; --bin)
+            fp_from[bin - 1] = fp_from[bin] + other[point * bin_count + bin - 1];
+
+        for (size_t t = 0; t < threshold_count; ++t)
+        {
+            size_t const bin = threshold_bin(args.thresholds[t]);
+            counts[point].fp.push_back(fp_from[bin]);
+            counts[point].fn.push_back(fn_below[bin]);
+        }
+    }
+    return counts;
+}
+
+void run_program(accuracy_arguments const & args)
+{
+    std::vector<std::vector<sequence_t>> references{};
+    for (auto const & path : args.references)
+        references.push_back(read_sequences(path));
+
+    std::vector<query_t> queries{};
+    for (size_t origin = 0; origin < args.queries.size(); ++origin)
+        for (sequence_t & sequence : read_sequences(args.queries[origin]))
+            queries.push_back({std::move(sequence), origin});
+
+    parameter_grid const grid = make_grid(args);
+    std::vector<accuracy_counts> const counts = sweep(args, grid, references, queries);
+
+    std::ofstream out{args.output};
+    bool const threshold_column = args.thresholds.size() > 1;
+
+    for (size_t const kmer : args.kmers)
+    {
+        for (size_t smer_index = 0; smer_index < grid.smers.size(); ++smer_index)
+        {
+            auto const & kmers = grid.kmers[smer_index];
+            auto const it = std::ranges::find(kmers, kmer);
+            if (it == kmers.end())
+                continue;
+
+            accuracy_counts const & point = counts[grid.index(smer_index, it - kmers.begin())];
+            for (size_t t = 0; t < args.thresholds.size(); ++t)
+            {
+                if (threshold_column)
+                    out << args.thresholds[t] << ',';
+                out << kmer << ',' << grid.smers[smer_index] << ',' << point.fp[t] << ',' << point.fn[t] << '\n';
+            }
+        }
+    }
+}
+
+void initialise_argument_parser(seqan3::argument_parser & parser, accuracy_arguments & args)
+{
+    parser.info.short_description = "Computes false positives and false negatives of hash-based read assignment.";
+    parser.info.description.push_back("Query file i contains reads of reference file i. Writes one CSV line "
+                                      "kmer,smer,fp,fn per parameter combination for src/plot_accuracy.r, with a "
+                                      "leading threshold column if several thresholds are given.");
+
+    parser.add_option(args.method, 'm', "method", "The sampling method.", seqan3::option_spec::standard,
+                      seqan3::value_list_validator{"syncmer", "opensyncmer", "minimiser", "minstrobe"});
+    parser.add_option(args.kmers, 'k', "kmer", "A k-mer size, repeat the option for several sizes.",
+                      seqan3::option_spec::required);
+    parser.add_option(args.smers, 's', "smer", "An s-mer size, repeat the option for several sizes.",
+                      seqan3::option_spec::required);
+    parser.add_option(args.thresholds, 't', "threshold", "A minimum fraction of matching hashes. Default: 0.5.",
+                      seqan3::option_spec::standard, seqan3::arithmetic_range_validator{0.0, 1.0});
+    parser.add_option(args.references, 'r', "reference", "A reference file, repeat the option for each reference.",
+                      seqan3::option_spec::required, seqan3::input_file_validator{});
+    parser.add_option(args.queries, 'q', "query", "The reads of the reference with the same index.",
+                      seqan3::option_spec::required, seqan3::input_file_validator{});
+    parser.add_option(args.threshold_step, 'T', "threshold-step", "Evaluate all multiples of this threshold step up to "
+                      "1 in addition to the given thresholds.", seqan3::option_spec::standard,
+                      seqan3::arithmetic_range_validator{0.0, 1.0});
+    parser.add_option(args.output, 'o', "output", "The CSV file to write.", seqan3::option_spec::required);
+    parser.add_option(args.threads, 'j', "threads", "The number of threads.", seqan3::option_spec::standard,
+                      seqan3::arithmetic_range_validator{1, 1024});
+}
+
+int main(int argc, char ** argv)
+{
+    seqan3::argument_parser parser{"accuracy", argc, argv};
+    accuracy_arguments args{};
+    initialise_argument_parser(parser, args);
+
+    try
+    {
+        parser.parse();
+
+        if (args.references.size() != args.queries.size())
+            throw seqan3::argument_parser_error{"Please give one query file per reference file."};
+
+        auto const multiple_of_bin = [] (double const threshold)
+        {
+            return std::abs(threshold * fraction_bins - threshold_bin(threshold)) < 1e-6;
+        };
+
+        if (!std::ranges::all_of(args.thresholds, multiple_of_bin) || !multiple_of_bin(args.threshold_step))
+            throw seqan3::argument_parser_error{"Please choose thresholds with at most three decimals."};
+
+        if (args.threshold_step > 0.0)
+        {
+            size_t const step = threshold_bin(args.threshold_step);
+            if (step == 0)
+                throw seqan3::argument_parser_error{"Please choose a threshold step of at least 0.001."};
+
+            for (size_t bin = step; bin <= fraction_bins; bin += step)
+                args.thresholds.push_back(static_cast<double>(bin) / fraction_bins);
+        }
+    }
+    catch (seqan3::argument_parser_error const & ext)
+    {
+        std::cerr << "[Error] " << ext.what() << '\n';
+        return -1;
+    }
+
+    if (args.thresholds.empty())
+        args.thresholds.push_back(0.5);
+
+    run_program(args);
+
+    return 0;
+}
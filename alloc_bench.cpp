@@ -0,0 +1,315 @@
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <random>
+#include <vector>
+
+#include <seqan3/alphabet/nucleotide/dna4.hpp>
+#include <seqan3/argument_parser/all.hpp>
+#include <seqan3/search/views/kmer_hash.hpp>
+#include <seqan3/search/views/minimiser_hash.hpp>
+#include <seqan3/search/views/minstrobe_hash.hpp>
+#include <seqan3/search/views/modmer_hash.hpp>
+#include <seqan3/search/views/multi_seed_hash.hpp>
+#include <seqan3/search/views/opensyncmer_hash.hpp>
+#include <seqan3/search/views/shared.hpp>
+#include <seqan3/search/views/streaming_sketcher.hpp>
+#include <seqan3/search/views/superkmer_hash.hpp>
+#include <seqan3/search/views/syncmer_hash.hpp>
+
+/* Counts the heap allocations of the sampling views and sketchers on a random sequence.
+ *
+ * The global operator new and delete of this program count every allocation. Every case runs on the first n and on
+ * all 2n bases of the sequence, and the difference of the two counts is attributed to the hot loop, so allocations of
+ * the setup, e.g. of the first window, cancel out. One CSV line
+ * "case,bases,samples,allocations_per_base,allocations_per_sample,bytes_per_base" is written per case.
+ *
+ * Cases marked as allocation-free must not allocate in the hot loop; if one does, the program reports it and returns
+ * 1, so a change that adds an allocation per element fails the benchmark.
+ */
+
+namespace
+{
+// The number of allocations of the program.
+std::atomic<uint64_t> allocation_count{0};
+// The number of bytes allocated by the program.
+std::atomic<uint64_t> allocation_bytes{0};
+
+void * counted_allocation(std::size_t const size, std::size_t const alignment)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+
+    std::size_t const rounded = (std::max<std::size_t>(size, 1) + alignment - 1) / alignment * alignment;
+    void * const pointer = alignment <= alignof(std::max_align_t) ? std::malloc(rounded)
+                                                                  : std::aligned_alloc(alignment, rounded);
+    if (pointer == nullptr)
+        throw std::bad_alloc{};
+    return pointer;
+}
+} // namespace
+
+void * operator new(std::size_t const size)
+{
+    return counted_allocation(size, alignof(std::max_align_t));
+}
+
+void * operator new[](std::size_t const size)
+{
+    return counted_allocation(size, alignof(std::max_align_t));
+}
+
+void * operator new(std::size_t const size, std::align_val_t const alignment)
+{
+    return counted_allocation(size, static_cast<std::size_t>(alignment));
+}
+
+void * operator new[](std::size_t const size, std::align_val_t const alignment)
+{
+    return counted_allocation(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void * const pointer) noexcept { std::free(pointer); }
+void operator delete[](void * const pointer) noexcept { std::free(pointer); }
+void operator delete(void * const pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void * const pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void * const pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete[](void * const pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete(void * const pointer, std::size_t, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete[](void * const pointer, std::size_t, std::align_val_t) noexcept { std::free(pointer); }
+
+struct alloc_bench_arguments
+{
+    size_t bases{1'000'000};
+    size_t kmer{15};
+    size_t smer{11};
+    uint64_t seed{42};
+};
+
+// The allocations and the number of samples of one run.
+struct run_counts
+{
+    uint64_t allocations{};
+    uint64_t bytes{};
+    uint64_t samples{};
+};
+
+// Runs `run(sequence)`, which returns the number of samples, and counts its allocations.
+template <typename run_t>
+run_counts count_run(run_t & run, std::span<seqan3::dna4 const> const sequence)
+{
+    uint64_t const allocations_before = allocation_count.load(std::memory_order_relaxed);
+    uint64_t const bytes_before = allocation_bytes.load(std::memory_order_relaxed);
+    uint64_t const samples = run(sequence);
+    return {allocation_count.load(std::memory_order_relaxed) - allocations_before,
+            allocation_bytes.load(std::memory_order_relaxed) - bytes_before,
+            samples};
+}
+
+// Reads a sample so that it is computed; strobes are returned by value and read element-wise.
+template <typename sample_t>
+uint64_t consume(sample_t const & sample)
+{
+    if constexpr (std::integral<sample_t>)
+        return sample;
+    else if constexpr (std::ranges::range<sample_t>)
+        return std::ranges::distance(sample);
+    else
+        return 1;
+}
+
+// Returns a run that traverses the view returned by `make_view(sequence)`.
+template <typename make_view_t>
+auto view_run(make_view_t make_view)
+{
+    return [make_view] (std::span<seqan3::dna4 const> const sequence)
+    {
+        uint64_t samples{};
+        uint64_t checksum{};
+        for (auto && sample : make_view(sequence))
+        {
+            checksum += consume(sample);
+            ++samples;
+        }
+        asm volatile("" : : "r"(checksum));
+        return samples;
+    };
+}
+
+// Returns a run that pushes the sequence into a sketcher in chunks of 4096 bases.
+template <typename sketcher_t>
+auto sketcher_run(sketcher_t sketcher)
+{
+    return [sketcher] (std::span<seqan3::dna4 const> const sequence) mutable
+    {
+        uint64_t samples{};
+        for (size_t start = 0; start < sequence.size(); start += 4096)
+            sketcher.push(sequence.subspan(start, std::min<size_t>(4096, sequence.size() - start)),
+                          [&samples] (uint64_t) { ++samples; });
+        sketcher.finish([&samples] (uint64_t) { ++samples; });
+        return samples;
+    };
+}
+
+// Returns a run of a multi-seed hash, counting the samples of all seeds.
+template <typename hash_t>
+auto multi_seed_run(hash_t hash)
+{
+    return [hash] (std::span<seqan3::dna4 const> const sequence)
+    {
+        uint64_t samples{};
+        hash(sequence, [&samples] (size_t, uint64_t) { ++samples; });
+        return samples;
+    };
+}
+
+// Measures one case and returns false if an allocation-free case allocates in its hot loop.
+template <typename run_t>
+bool measure(std::string_view const name, bool const allocation_free, run_t run,
+             std::span<seqan3::dna4 const> const sequence)
+{
+    // A first run performs one-time initialisations, e.g. the registration of a profiler stage.
+    size_t const half = sequence.size() / 2;
+    count_run(run, sequence.first(half));
+    run_counts const first = count_run(run, sequence.first(half));
+    run_counts const both = count_run(run, sequence);
+
+    double const bases = sequence.size() - half;
+    double const allocations = static_cast<double>(both.allocations) - first.allocations;
+    double const samples = static_cast<double>(both.samples) - first.samples;
+    std::cout << name << ',' << sequence.size() << ',' << both.samples << ',' << allocations / bases << ','
+              << (samples > 0 ? allocations / samples : 0.0) << ','
+              << (static_cast<double>(both.bytes) - first.bytes) / bases << '\n';
+
+    if (allocation_free && both.allocations > first.allocations)
+    {
+        std::cerr << "[Error] " << name << " is marked as allocation-free but allocates "
+                  << both.allocations - first.allocations << " times more on " << sequence.size() - half
+                  << " more bases.\n";
+        return false;
+    }
+    return true;
+}
+
+bool run_program(alloc_bench_arguments const & args)
+{
+    std::mt19937_64 random{args.seed};
+    std::vector<seqan3::dna4> sequence(args.bases);
+    for (seqan3::dna4 & base : sequence)
+        base.assign_rank(random() % 4);
+
+    size_t const k = args.kmer;
+    size_t const s = args.smer;
+    seqan3::shape const kmer_shape{seqan3::ungapped{static_cast<uint8_t>(k)}};
+    seqan3::shape const smer_shape{seqan3::ungapped{static_cast<uint8_t>(s)}};
+    seqan3::window_size const window{static_cast<uint32_t>(k + 4)};
+    std::array<uint64_t, 4> const seeds{1, 2, 3, 4};
+
+    bool passed{true};
+    std::cout << "case,bases,samples,allocations_per_base,allocations_per_sample,bytes_per_base\n";
+
+    passed &= measure("kmer_hash", true, view_run([=] (auto sequence)
+    {
+        return sequence | seqan3::views::kmer_hash(kmer_shape);
+    }), sequence);
+    passed &= measure("fnv_hash", true, [=] (std::span<seqan3::dna4 const> const sequence)
+    {
+        uint64_t checksum{};
+        for (uint64_t const hash : sequence | seqan3::views::kmer_hash(kmer_shape))
+            checksum ^= fnv_hash(hash, 0x8F3F73B5CF1C9ADE);
+        asm volatile("" : : "r"(checksum));
+        return static_cast<uint64_t>(sequence.size() - k + 1);
+    }, sequence);
+    passed &= measure("syncmer_hash", true, view_run([=] (auto sequence)
+    {
+        return sequence | syncmer_hash(s, k);
+    }), sequence);
+    passed &= measure("opensyncmer_hash", true, view_run([=] (auto sequence)
+    {
+        return sequence | opensyncmer_hash(s, k);
+    }), sequence);
+    passed &= measure("minimiser_hash", true, view_run([=] (auto sequence)
+    {
+        return sequence | seqan3::views::minimiser_hash(kmer_shape, window);
+    }), sequence);
+    passed &= measure("minstrobe_hash", true, view_run([=] (auto sequence)
+    {
+        return sequence | minstrobe_hash(smer_shape, 4, 10);
+    }), sequence);
+    passed &= measure("modmer_hash", true, view_run([=] (auto sequence)
+    {
+        return sequence | modmer_hash(kmer_shape, 4);
+    }), sequence);
+    passed &= measure("superkmer_hash", true, view_run([=] (auto sequence)
+    {
+        return sequence | superkmer_hash(smer_shape, window);
+    }), sequence);
+    // Post-increment copies the iterator at every sample, as do many generic algorithms.
+    passed &= measure("syncmer_hash_iterator_copies", true, [=] (std::span<seqan3::dna4 const> const sequence)
+    {
+        auto view = sequence | syncmer_hash(s, k);
+        uint64_t samples{};
+        uint64_t checksum{};
+        for (auto it = std::ranges::begin(view); it != std::ranges::end(view); ++samples)
+            checksum += *it++;
+        asm volatile("" : : "r"(checksum));
+        return samples;
+    }, sequence);
+    passed &= measure("minimiser_hash_iterator_copies", true, [=] (std::span<seqan3::dna4 const> const sequence)
+    {
+        auto view = sequence | seqan3::views::minimiser_hash(kmer_shape, window);
+        uint64_t samples{};
+        uint64_t checksum{};
+        for (auto it = std::ranges::begin(view); it != std::ranges::end(view); ++samples)
+            checksum += *it++;
+        asm volatile("" : : "r"(checksum));
+        return samples;
+    }, sequence);
+    passed &= measure("syncmer_sketcher", true, sketcher_run(seqan3::syncmer_sketcher<>{s, k}), sequence);
+    passed &= measure("minimiser_sketcher", true, sketcher_run(seqan3::minimiser_sketcher{kmer_shape, window}),
+                      sequence);
+    passed &= measure("multi_seed_syncmer_hash", true,
+                      multi_seed_run(seqan3::multi_seed_syncmer_hash<4>{s, k, seeds}), sequence);
+    passed &= measure("multi_seed_minimiser_hash", true,
+                      multi_seed_run(seqan3::multi_seed_minimiser_hash<4>{kmer_shape, window, seeds}), sequence);
+
+    return passed;
+}
+
+void initialise_argument_parser(seqan3::argument_parser & parser, alloc_bench_arguments & args)
+{
+    parser.info.short_description = "Counts the heap allocations per base and per sample of the sampling views.";
+    parser.info.description.push_back("Returns 1 if a case marked as allocation-free allocates in its hot loop.");
+
+    parser.add_option(args.bases, 'n', "bases", "The length of the random sequence.", seqan3::option_spec::standard,
+                      seqan3::arithmetic_range_validator{1000, 1'000'000'000});
+    parser.add_option(args.kmer, 'k', "kmer", "The k-mer size; the minimiser window is k + 4.",
+                      seqan3::option_spec::standard, seqan3::arithmetic_range_validator{2, 28});
+    parser.add_option(args.smer, 's', "smer", "The s-mer size, also the shape of minstrobes and super-k-mers.",
+                      seqan3::option_spec::standard, seqan3::arithmetic_range_validator{1, 27});
+    parser.add_option(args.seed, 'r', "random-seed", "The seed of the random sequence.",
+                      seqan3::option_spec::standard);
+}
+
+int main(int argc, char ** argv)
+{
+    seqan3::argument_parser parser{"alloc_bench", argc, argv};
+    alloc_bench_arguments args{};
+    initialise_argument_parser(parser, args);
+
+    try
+    {
+        parser.parse();
+
+        if (args.smer >= args.kmer)
+            throw seqan3::argument_parser_error{"Please choose an s-mer size smaller than the k-mer size."};
+    }
+    catch (seqan3::argument_parser_error const & ext)
+    {
+        std::cerr << "[Error] " << ext.what() << '\n';
+        return -1;
+    }
+
+    return run_program(args) ? 0 : 1;
+}
@@ -0,0 +1,103 @@
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include <seqan3/argument_parser/all.hpp>
+#include <seqan3/search/views/containment_search.hpp>
+#include <seqan3/search/views/sketch_file.hpp>
+
+/* Compares all query sketches with all reference sketches, both written by the sketch tool, and writes one CSV line
+ * "query,reference,shared,containment" per pair whose containment of the query in the reference is at least the
+ * threshold.
+ */
+
+struct compare_arguments
+{
+    std::filesystem::path queries{};
+    std::filesystem::path references{};
+    double threshold{0.5};
+    std::filesystem::path output{};
+    size_t threads{1};
+};
+
+std::vector<std::vector<uint64_t>> decode_all(seqan3::sketch_file const & file)
+{
+    std::vector<std::vector<uint64_t>> sketches(file.size());
+    for (size_t id = 0; id < file.size(); ++id)
+        file.decode(id, sketches[id]);
+    return sketches;
+}
+
+void run_program(compare_arguments const & args)
+{
+    seqan3::sketch_file const query_file{args.queries};
+    seqan3::sketch_file const reference_file{args.references};
+
+    if (query_file.parameters() != reference_file.parameters())
+        throw std::invalid_argument{"The query and reference sketches were computed with different parameters."};
+
+    std::vector<std::vector<uint64_t>> const references = decode_all(reference_file);
+    seqan3::containment_search const search{references, args.threads};
+
+    std::vector<std::vector<uint64_t>> const queries = decode_all(query_file);
+    std::vector<seqan3::containment_hit> const hits = search.search(queries, args.threshold, args.threads);
+
+    std::ofstream out{args.output};
+    for (seqan3::containment_hit const & hit : hits)
+        out << query_file.name(hit.query) << ',' << reference_file.name(hit.reference) << ','
+            << hit.shared << ',' << hit.containment << '\n';
+}
+
+void initialise_argument_parser(seqan3::argument_parser & parser, compare_arguments & args)
+{
+    parser.info.short_description = "Finds all pairs of query and reference sketches with a large containment.";
+
+    parser.add_option(args.queries, 'q', "queries", "The sketch file of the queries.", seqan3::option_spec::required,
+                      seqan3::input_file_validator{});
+    parser.add_option(args.references, 'r', "references", "The sketch file of the references.",
+                      seqan3::option_spec::required, seqan3::input_file_validator{});
+    parser.add_option(args.threshold, 't', "threshold", "The minimum fraction of query hashes in the reference.",
+                      seqan3::option_spec::standard, seqan3::arithmetic_range_validator{0.0, 1.0});
+    parser.add_option(args.output, 'o', "output", "The CSV file to write.", seqan3::option_spec::required);
+    parser.add_option(args.threads, 'j', "threads", "The number of threads.", seqan3::option_spec::standard,
+                      seqan3::arithmetic_range_validator{1, 1024});
+}
+
+int main(int argc, char ** argv)
+{
+    seqan3::argument_parser parser{"compare", argc, argv};
+    compare_arguments args{};
+    initialise_argument_parser(parser, args);
+
+    try
+    {
+        parser.parse();
+    }
+    catch (seqan3::argument_parser_error const & ext)
+    {
+        std::cerr << "[Error] " << ext.what() << '\n';
+        return -1;
+    }
+
+    try
+    {
+        run_program(args);
+    }
+    catch (std::invalid_argument const & ext) // The sketch files were computed with different parameters.
+    {
+        std::cerr << "[Error] " << ext.what() << '\n';
+        return -1;
+    }
+    catch (seqan3::file_open_error const & ext)
+    {
+        std::cerr << "[Error] " << ext.what() << '\n';
+        return -1;
+    }
+    catch (seqan3::format_error const & ext)
+    {
+        std::cerr << "[Error] " << ext.what() << '\n';
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,397 @@
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <seqan3/alphabet/nucleotide/dna4.hpp>
+#include <seqan3/argument_parser/all.hpp>
+#include <seqan3/search/views/minimiser_hash.hpp>
+#include <seqan3/search/views/minstrobe_hash.hpp>
+#include <seqan3/search/views/modmer_hash.hpp>
+#include <seqan3/search/views/opensyncmer_hash.hpp>
+#include <seqan3/search/views/syncmer_hash.hpp>
+
+/* Measures how well the samples of syncmer_hash, opensyncmer_hash, minimiser_hash, minstrobe_hash and modmer_hash are
+ * conserved under random mutations, together with their density, the gaps between samples and their throughput.
+ *
+ * Every replicate is a random sequence generated from a fixed seed; for every mutation rate a mutated copy with
+ * substitutions and insertions or deletions at the given rates is derived from it. All methods and (k, s) combinations
+ * are evaluated on the same sequences, the tasks are spread over the threads.
+ *
+ * For every method, <output>_<method>_conservation.csv gets one line
+ * "kmer,smer,substitution_rate,indel_rate,density,conservation,mean_gap,max_gap,mbp_per_second" per combination and
+ * rate, averaged over the replicates, and <output>_<method>_gaps.csv one line "kmer,smer,gap,count" per gap length
+ * between consecutive samples of the unmutated sequences. Both have no header, like the files read by
+ * src/plot_accuracy.r.
+ *
+ * Density is the number of samples per k-mer, conservation the fraction of distinct samples of the original sequence
+ * that are also samples of the mutated copy. The parameters are mapped like in the accuracy tool; modmer samples
+ * k-mers with mod (k - s + 2) / 2, which has about the density of closed syncmers.
+ */
+
+using sequence_t = std::vector<seqan3::dna4>;
+
+std::vector<std::string> const methods{"syncmer", "opensyncmer", "minimiser", "minstrobe", "modmer"};
+
+// The seed of the *_hash views.
+constexpr uint64_t default_seed{0x8F3F73B5CF1C9ADE};
+
+struct conservation_arguments
+{
+    size_t length{1'000'000};
+    size_t replicates{1};
+    uint64_t seed{42};
+    std::vector<size_t> kmers{};
+    std::vector<size_t> smers{};
+    std::vector<double> substitution_rates{};
+    std::vector<double> indel_rates{};
+    std::string output{"data"};
+    size_t threads{1};
+};
+
+// The samples of one method on one sequence: the value compared between sequences and the position of each sample.
+struct samples_t
+{
+    std::vector<uint64_t> values{};
+    std::vector<size_t> positions{};
+    double seconds{};
+};
+
+// The accumulated results of one method, (k, s) combination and mutation rate.
+struct result_t
+{
+    double density{};
+    double conservation{};
+    double mean_gap{};
+    size_t max_gap{};
+    double mbp_per_second{};
+};
+
+sequence_t random_sequence(size_t const length, std::mt19937_64 & generator)
+{
+    sequence_t sequence(length);
+    for (seqan3::dna4 & base : sequence)
+        seqan3::assign_rank_to(generator() % 4, base);
+    return sequence;
+}
+
+// Substitutes every base with probability `substitution_rate`; with probability `indel_rate` a base is deleted or a
+// random base is inserted before it, both with the same probability.
+sequence_t mutate(sequence_t const & original, double const substitution_rate, double const indel_rate,
+                  std::mt19937_64 & generator)
+{
+    std::uniform_real_distribution<double> uniform{0.0, 1.0};
+    auto random_base = [&] () { seqan3::dna4 base{}; return seqan3::assign_rank_to(generator() % 4, base); };
+
+    sequence_t mutated{};
+    mutated.reserve(original.size() + original.size() * indel_rate);
+
+    for (seqan3::dna4 base : original)
+    {
+        double const indel = uniform(generator);
+        if (indel < indel_rate / 2)
+            continue;
+        if (indel < indel_rate)
+            mutated.push_back(random_base());
+
+        if (uniform(generator) < substitution_rate)
+        {
+            seqan3::dna4 substitute{};
+            seqan3::assign_rank_to((seqan3::to_rank(base) + 1 + generator() % 3) % 4, substitute);
+            base = substitute;
+        }
+        mutated.push_back(base);
+    }
+
+    return mutated;
+}
+
+bool valid_parameters(std::string const & method, size_t const kmer, size_t const smer)
+{
+    if (smer == 0 || smer > 32 || kmer > 32 || smer >= kmer)
+        return false;
+
+    if (method == "minstrobe")
+        return smer > 1 && kmer >= 2 * smer;
+
+    return true;
+}
+
+// The positions of the samples `keys`, which are in the order of the sequence, in the stream of k-mer or s-mer
+// hashes they were sampled from. Every sample is matched to the next occurrence of its key after the previous sample.
+std::vector<size_t> sample_positions(std::vector<uint64_t> const & keys, std::ranges::input_range auto && hashes)
+{
+    std::vector<size_t> positions{};
+    positions.reserve(keys.size());
+
+    size_t position{0};
+    for (uint64_t const hash : hashes)
+    {
+        if (positions.size() == keys.size())
+            break;
+        if (hash == keys[positions.size()])
+            positions.push_back(position);
+        ++position;
+    }
+
+    return positions;
+}
+
+// Runs the method and returns its samples; the positions are only computed if `with_positions` is true.
+samples_t sample(std::string const & method, size_t const kmer, size_t const smer, sequence_t const & sequence,
+                 bool const with_positions)
+{
+    samples_t samples{};
+    if (sequence.size() < kmer)
+        return samples;
+
+    auto const seeded = std::views::transform([] (uint64_t const hash) { return hash ^ default_seed; });
+    auto const kmer_shape = seqan3::shape{seqan3::ungapped{static_cast<uint8_t>(kmer)}};
+    auto const smer_shape = seqan3::shape{seqan3::ungapped{static_cast<uint8_t>(smer)}};
+    // For minstrobe, the position of a sample is the position of its first strobe.
+    std::vector<uint64_t> position_keys{};
+
+    auto const start = std::chrono::steady_clock::now();
+    if (method == "syncmer")
+    {
+        for (uint64_t const hash : sequence | syncmer_hash(smer, kmer))
+            samples.values.push_back(hash);
+    }
+    else if (method == "opensyncmer")
+    {
+        for (uint64_t const hash : sequence | opensyncmer_hash(smer, kmer))
+            samples.values.push_back(hash);
+    }
+    else if (method == "minimiser")
+    {
+        seqan3::window_size const window{static_cast<uint32_t>(kmer)};
+        for (uint64_t const hash : sequence | seqan3::views::minimiser_hash(smer_shape, window))
+            samples.values.push_back(hash);
+    }
+    else if (method == "minstrobe")
+    {
+        for (auto const & strobes : sequence | minstrobe_hash(smer_shape, smer, kmer - smer))
+        {
+            samples.values.push_back(mix_hash(strobes[0]) ^ strobes[1]);
+            position_keys.push_back(strobes[0]);
+        }
+    }
+    else
+    {
+        for (uint64_t const hash : sequence | modmer_hash(kmer_shape, (kmer - smer + 2) / 2))
+            samples.values.push_back(hash);
+    }
+    samples.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (!with_positions)
+        return samples;
+
+    std::vector<uint64_t> const & keys = method == "minstrobe" ? position_keys : samples.values;
+    if (method == "minimiser")
+    {
+        auto reverse = sequence | seqan3::views::complement
+                                | std::views::reverse
+                                | seqan3::views::kmer_hash(smer_shape)
+                                | seeded
+                                | std::views::reverse;
+        samples.positions = sample_positions(keys,
+                                             seqan3::views::zip(sequence | seqan3::views::kmer_hash(smer_shape)
+                                                                         | seeded,
+                                                                reverse)
+                                             | std::views::transform([] (auto const strands)
+                                             {
+                                                 return std::min(std::get<0>(strands), std::get<1>(strands));
+                                             }));
+    }
+    else if (method == "minstrobe")
+    {
+        samples.positions = sample_positions(keys, sequence | seqan3::views::kmer_hash(smer_shape) | seeded);
+    }
+    else
+    {
+        samples.positions = sample_positions(keys, sequence | seqan3::views::kmer_hash(kmer_shape) | seeded);
+    }
+
+    return samples;
+}
+
+void run_program(conservation_arguments const & args)
+{
+    size_t const rate_count = args.substitution_rates.size();
+
+    // The sequences of all replicates; mutated[replicate * rate_count + rate] is a mutated copy of original[replicate].
+    std::vector<sequence_t> original{};
+    std::vector<sequence_t> mutated{};
+    for (size_t replicate = 0; replicate < args.replicates; ++replicate)
+    {
+        std::mt19937_64 generator{args.seed + replicate};
+        original.push_back(random_sequence(args.length, generator));
+        for (size_t rate = 0; rate < rate_count; ++rate)
+            mutated.push_back(mutate(original.back(), args.substitution_rates[rate], args.indel_rates[rate],
+                                     generator));
+    }
+
+    struct task_t
+    {
+        std::string method;
+        size_t kmer;
+        size_t smer;
+    };
+
+    std::vector<task_t> tasks{};
+    for (std::string const & method : methods)
+        for (size_t const kmer : args.kmers)
+            for (size_t const smer : args.smers)
+                if (valid_parameters(method, kmer, smer))
+                    tasks.push_back({method, kmer, smer});
+
+    // results[task * rate_count + rate] and gaps[task][gap], both summed over the replicates.
+    std::vector<result_t> results(tasks.size() * rate_count);
+    std::vector<std::map<size_t, size_t>> gaps(tasks.size());
+    std::atomic<size_t> next{0};
+
+    auto worker = [&] ()
+    {
+        for (size_t id = next++; id < tasks.size(); id = next++)
+        {
+            task_t const & task = tasks[id];
+
+            for (size_t replicate = 0; replicate < args.replicates; ++replicate)
+            {
+                samples_t const samples = sample(task.method, task.kmer, task.smer, original[replicate], true);
+                std::unordered_set<uint64_t> const values(samples.values.begin(), samples.values.end());
+
+                size_t gap_sum{0};
+                size_t gap_count{0};
+                size_t max_gap{0};
+                for (size_t i = 1; i < samples.positions.size(); ++i)
+                {
+                    size_t const gap = samples.positions[i] - samples.positions[i - 1];
+                    ++gaps[id][gap];
+                    gap_sum += gap;
+                    ++gap_count;
+                    max_gap = std::max(max_gap, gap);
+                }
+
+                for (size_t rate = 0; rate < rate_count; ++rate)
+                {
+                    samples_t const mutated_samples = sample(task.method, task.kmer, task.smer,
+                                                             mutated[replicate * rate_count + rate], false);
+                    std::unordered_set<uint64_t> const mutated_values(mutated_samples.values.begin(),
+                                                                      mutated_samples.values.end());
+                    size_t conserved{0};
+                    for (uint64_t const value : values)
+                        conserved += mutated_values.contains(value);
+
+                    result_t & result = results[id * rate_count + rate];
+                    result.density += static_cast<double>(samples.values.size()) / (args.length - task.kmer + 1);
+                    result.conservation += values.empty() ? 0.0 : static_cast<double>(conserved) / values.size();
+                    result.mean_gap += gap_count == 0 ? 0.0 : static_cast<double>(gap_sum) / gap_count;
+                    result.max_gap = std::max(result.max_gap, max_gap);
+                    result.mbp_per_second += args.length / samples.seconds / 1e6;
+                }
+            }
+        }
+    };
+
+    {
+        std::vector<std::jthread> workers{};
+        for (size_t thread = 1; thread < args.threads; ++thread)
+            workers.emplace_back(worker);
+        worker();
+    }
+
+    for (std::string const & method : methods)
+    {
+        std::ofstream conservation_out{args.output + "_" + method + "_conservation.csv"};
+        std::ofstream gaps_out{args.output + "_" + method + "_gaps.csv"};
+
+        for (size_t id = 0; id < tasks.size(); ++id)
+        {
+            task_t const & task = tasks[id];
+            if (task.method != method)
+                continue;
+
+            for (size_t rate = 0; rate < rate_count; ++rate)
+            {
+                result_t const & result = results[id * rate_count + rate];
+                conservation_out << task.kmer << ',' << task.smer << ','
+                                 << args.substitution_rates[rate] << ',' << args.indel_rates[rate] << ','
+                                 << result.density / args.replicates << ','
+                                 << result.conservation / args.replicates << ','
+                                 << result.mean_gap / args.replicates << ','
+                                 << result.max_gap << ','
+                                 << result.mbp_per_second / args.replicates << '\n';
+            }
+
+            for (auto const & [gap, count] : gaps[id])
+                gaps_out << task.kmer << ',' << task.smer << ',' << gap << ',' << count << '\n';
+        }
+    }
+}
+
+void initialise_argument_parser(seqan3::argument_parser & parser, conservation_arguments & args)
+{
+    parser.info.short_description = "Measures density, conservation, gaps and throughput of the sampling schemes.";
+    parser.info.description.push_back("Writes <output>_<method>_conservation.csv with the lines kmer,smer,"
+                                      "substitution_rate,indel_rate,density,conservation,mean_gap,max_gap,"
+                                      "mbp_per_second and <output>_<method>_gaps.csv with the lines kmer,smer,gap,"
+                                      "count for syncmer, opensyncmer, minimiser, minstrobe and modmer.");
+
+    parser.add_option(args.length, 'l', "length", "The length of the random sequences.",
+                      seqan3::option_spec::standard, seqan3::arithmetic_range_validator{1, 1'000'000'000});
+    parser.add_option(args.replicates, 'n', "replicates", "The number of random sequences.",
+                      seqan3::option_spec::standard, seqan3::arithmetic_range_validator{1, 100'000});
+    parser.add_option(args.seed, 'r', "seed", "The seed of the first random sequence.");
+    parser.add_option(args.kmers, 'k', "kmer", "A k-mer size, repeat the option for several sizes.",
+                      seqan3::option_spec::required);
+    parser.add_option(args.smers, 's', "smer", "An s-mer size, repeat the option for several sizes.",
+                      seqan3::option_spec::required);
+    parser.add_option(args.substitution_rates, 'x', "substitution-rate", "A substitution rate, repeat the option "
+                      "for several rates. Default: 0.01.", seqan3::option_spec::standard,
+                      seqan3::arithmetic_range_validator{0.0, 1.0});
+    parser.add_option(args.indel_rates, 'i', "indel-rate", "The indel rate of the substitution rate with the same "
+                      "index. Default: 0.", seqan3::option_spec::standard,
+                      seqan3::arithmetic_range_validator{0.0, 1.0});
+    parser.add_option(args.output, 'o', "output", "The prefix of the CSV files.");
+    parser.add_option(args.threads, 'j', "threads", "The number of threads.", seqan3::option_spec::standard,
+                      seqan3::arithmetic_range_validator{1, 1024});
+}
+
+int main(int argc, char ** argv)
+{
+    seqan3::argument_parser parser{"conservation", argc, argv};
+    conservation_arguments args{};
+    initialise_argument_parser(parser, args);
+
+    try
+    {
+        parser.parse();
+
+        if (args.substitution_rates.empty())
+            args.substitution_rates.push_back(0.01);
+
+        if (args.indel_rates.empty())
+            args.indel_rates.assign(args.substitution_rates.size(), 0.0);
+
+        if (args.indel_rates.size() != args.substitution_rates.size())
+            throw seqan3::argument_parser_error{"Please give one indel rate per substitution rate."};
+
+        if (args.length < std::ranges::max(args.kmers))
+            throw seqan3::argument_parser_error{"Please choose a length of at least the largest k-mer size."};
+    }
+    catch (seqan3::argument_parser_error const & ext)
+    {
+        std::cerr << "[Error] " << ext.what() << '\n';
+        return -1;
+    }
+
+    run_program(args);
+
+    return 0;
+}
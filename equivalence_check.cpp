@@ -0,0 +1,351 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <set>
+#include <span>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <seqan3/alphabet/nucleotide/dna4.hpp>
+#include <seqan3/argument_parser/all.hpp>
+#include <seqan3/search/views/minimiser_hash.hpp>
+#include <seqan3/search/views/multi_seed_hash.hpp>
+#include <seqan3/search/views/opensyncmer_hash.hpp>
+#include <seqan3/search/views/sketch_distance.hpp>
+#include <seqan3/search/views/streaming_sketcher.hpp>
+#include <seqan3/search/views/syncmer_hash.hpp>
+
+/* Checks that the reimplementations of the sampling views give the same hashes as the views.
+ *
+ * Every round draws a random sequence and random parameters. The sequences use 1 to 4 letters, so that low-complexity
+ * sequences with many equal hashes exercise the tie rules. Lane i of seqan3::multi_seed_syncmer_hash and
+ * seqan3::multi_seed_minimiser_hash must equal syncmer_hash, opensyncmer_hash or seqan3::views::minimiser_hash with
+ * seed i; the first seed is the default seed of the views. seqan3::syncmer_sketcher and seqan3::minimiser_sketcher
+ * must return the hashes of the view on the whole sequence when it is pushed in random chunks, including empty chunks,
+ * chunks of single bases and sequences shorter than a k-mer or the window. Every sketcher is reused for a second
+ * sequence after finish(), or after reset() and a discarded partial push.
+ *
+ * seqan3::intersection_count and each of its kernels, the scalar merge, the exponential search and, on processors with
+ * AVX2, the vector merge, must count the common hashes of two random sorted sketches with a known intersection. The
+ * sketches include empty ones, sizes that are not a multiple of four and size ratios around the threshold of 64 at
+ * which seqan3::intersection_count switches to the exponential search.
+ *
+ * One CSV line "case,rounds,mismatches" is written per case. The parameters of the first mismatch of a case are
+ * reported, and the program returns 1 if any case has a mismatch.
+ */
+
+struct equivalence_check_arguments
+{
+    size_t rounds{500};
+    size_t max_length{500};
+    uint64_t seed{42};
+};
+
+// The number of seeds of the multi-seed hashes.
+constexpr size_t seed_count{8};
+
+// The rounds and mismatches of one case.
+struct check_counts
+{
+    uint64_t rounds{};
+    uint64_t mismatches{};
+};
+
+// Draws a sequence of `length` characters over the first 1 to 4 letters of seqan3::dna4.
+std::vector<seqan3::dna4> random_sequence(std::mt19937_64 & random, size_t const length)
+{
+    size_t const letters = 1 + random() % 4;
+    std::vector<seqan3::dna4> sequence(length);
+    for (seqan3::dna4 & base : sequence)
+        base.assign_rank(random() % letters);
+    return sequence;
+}
+
+// Collects the hashes of a view.
+template <typename view_t>
+std::vector<uint64_t> collect(view_t && view)
+{
+    std::vector<uint64_t> hashes{};
+    for (uint64_t const hash : view)
+        hashes.push_back(hash);
+    return hashes;
+}
+
+// Counts a round; reports the parameters `what` of the first mismatch of the case.
+void count_round(check_counts & counts, std::string_view const name, bool const equal, std::string const & what)
+{
+    ++counts.rounds;
+    if (equal)
+        return;
+
+    if (counts.mismatches++ == 0)
+        std::cerr << "[Error] " << name << " differs from its reference for " << what << ".\n";
+}
+
+// Writes the CSV line of a case and returns whether it had no mismatch.
+bool report(std::string_view const name, check_counts const & counts)
+{
+    std::cout << name << ',' << counts.rounds << ',' << counts.mismatches << '\n';
+    return counts.mismatches == 0;
+}
+
+// Compares every lane of a multi-seed syncmer hash with the view `make_view(sequence, smers, kmers, seed)`.
+template <typename offsets_t, typename make_view_t>
+bool check_multi_seed_syncmer(std::string_view const name, equivalence_check_arguments const & args,
+                              std::mt19937_64 & random, make_view_t make_view)
+{
+    std::array<uint64_t, seed_count> seeds{0x8F3F73B5CF1C9ADE};
+    for (size_t lane = 1; lane < seed_count; ++lane)
+        seeds[lane] = random();
+
+    check_counts counts{};
+    for (size_t round = 0; round < args.rounds; ++round)
+    {
+        size_t const kmers = 2 + random() % 31;
+        size_t const smers = 1 + random() % (kmers - 1);
+        // The views throw for sequences shorter than a k-mer.
+        std::vector<seqan3::dna4> const sequence = random_sequence(random, kmers + random() % args.max_length);
+
+        auto const streams = seqan3::multi_seed_syncmer_hash<seed_count, offsets_t>{smers, kmers, seeds}(sequence);
+        bool equal{true};
+        for (size_t lane = 0; lane < seed_count; ++lane)
+            equal &= streams[lane] == collect(make_view(sequence, smers, kmers, seqan3::seed{seeds[lane]}));
+
+        count_round(counts, name, equal, "k = " + std::to_string(kmers) + ", s = " + std::to_string(smers) +
+                                         " and " + std::to_string(sequence.size()) + " bases");
+    }
+    return report(name, counts);
+}
+
+// Compares every lane of a multi-seed minimiser hash with seqan3::views::minimiser_hash.
+bool check_multi_seed_minimiser(equivalence_check_arguments const & args, std::mt19937_64 & random)
+{
+    std::array<uint64_t, seed_count> seeds{0x8F3F73B5CF1C9ADE};
+    for (size_t lane = 1; lane < seed_count; ++lane)
+        seeds[lane] = random();
+
+    check_counts counts{};
+    for (size_t round = 0; round < args.rounds; ++round)
+    {
+        size_t const shape_size = 1 + random() % 32;
+        size_t const window = shape_size + random() % 40;
+        // The view throws for sequences shorter than the window.
+        std::vector<seqan3::dna4> const sequence = random_sequence(random, window + random() % args.max_length);
+        seqan3::shape const shape{seqan3::ungapped{static_cast<uint8_t>(shape_size)}};
+        seqan3::window_size const window_size{static_cast<uint32_t>(window)};
+
+        auto const streams = seqan3::multi_seed_minimiser_hash<seed_count>{shape, window_size, seeds}(sequence);
+        bool equal{true};
+        for (size_t lane = 0; lane < seed_count; ++lane)
+            equal &= streams[lane] == collect(sequence | seqan3::views::minimiser_hash(shape, window_size,
+                                                                                      seqan3::seed{seeds[lane]}));
+
+        count_round(counts, "multi_seed_minimiser_hash", equal, "shape size " + std::to_string(shape_size) +
+                    ", window " + std::to_string(window) + " and " + std::to_string(sequence.size()) + " bases");
+    }
+    return report("multi_seed_minimiser_hash", counts);
+}
+
+// Pushes a sequence into a sketcher in random chunks and returns the hashes, including those of finish().
+template <typename sketcher_t>
+std::vector<uint64_t> push_chunked(sketcher_t & sketcher, std::span<seqan3::dna4 const> const sequence,
+                                   std::mt19937_64 & random)
+{
+    std::vector<uint64_t> hashes{};
+    auto const append = [&hashes] (uint64_t const hash) { hashes.push_back(hash); };
+
+    for (size_t start = 0; start < sequence.size(); )
+    {
+        size_t const draw = random() % 8;
+        size_t const chunk = std::min<size_t>(draw == 0 ? 0 : draw < 4 ? 1 + random() % 3 : 1 + random() % 100,
+                                              sequence.size() - start);
+        sketcher.push(sequence.subspan(start, chunk), append);
+        start += chunk;
+    }
+    sketcher.finish(append);
+    return hashes;
+}
+
+// Compares a sketcher with its view on two sequences; `make(random)` returns the sketcher, a function computing the
+// expected hashes of a sequence with the view, the shortest sequence the view accepts and the parameters.
+template <typename make_t>
+bool check_sketcher(std::string_view const name, equivalence_check_arguments const & args,
+                    std::mt19937_64 & random, make_t make)
+{
+    check_counts counts{};
+    for (size_t round = 0; round < args.rounds; ++round)
+    {
+        auto [sketcher, expected, min_length, what] = make(random);
+
+        bool equal{true};
+        for (size_t repetition = 0; repetition < 2; ++repetition)
+        {
+            std::vector<seqan3::dna4> const sequence = random_sequence(random, random() % args.max_length);
+            std::vector<uint64_t> const hashes = sequence.size() < min_length ? std::vector<uint64_t>{}
+                                                                              : expected(sequence);
+            equal &= push_chunked(sketcher, sequence, random) == hashes;
+            what += (repetition == 0 ? " on " : " and ") + std::to_string(sequence.size()) + " bases";
+
+            if (repetition == 0 && random() % 2)
+            {
+                sketcher.push(std::span<seqan3::dna4 const>{sequence}.first(sequence.size() / 2), [] (uint64_t) {});
+                sketcher.reset();
+                what += " after a reset";
+            }
+        }
+        count_round(counts, name, equal, what);
+    }
+    return report(name, counts);
+}
+
+// Returns the parameters of a syncmer sketcher check for the view `make_view(sequence, smers, kmers, seed)`.
+template <typename offsets_t, typename make_view_t>
+auto syncmer_sketcher_case(make_view_t make_view)
+{
+    return [make_view] (std::mt19937_64 & random)
+    {
+        size_t const kmers = 2 + random() % 31;
+        size_t const smers = 1 + random() % (kmers - 1);
+        seqan3::seed const seed{random() % 2 ? 0x8F3F73B5CF1C9ADE : random()};
+        auto const expected = [=] (std::vector<seqan3::dna4> const & sequence)
+        {
+            return collect(make_view(sequence, smers, kmers, seed));
+        };
+        // The views throw for sequences shorter than a k-mer, the sketcher returns no hashes.
+        return std::tuple{seqan3::syncmer_sketcher<offsets_t>{smers, kmers, seed}, expected, kmers,
+                          "k = " + std::to_string(kmers) + ", s = " + std::to_string(smers)};
+    };
+}
+
+// Compares seqan3::intersection_count and its kernels with the known intersection size of two random sketches.
+bool check_intersection_count(equivalence_check_arguments const & args, std::mt19937_64 & random)
+{
+    check_counts counts{};
+    for (size_t round = 0; round < args.rounds; ++round)
+    {
+        size_t const small_size = random() % 20;
+        size_t large_size{};
+        switch (random() % 3)
+        {
+            case 0: large_size = small_size + random() % 64; break;
+            // b.size() / a.size() is 63 to 66; seqan3::intersection_count gallops from 65.
+            case 1: large_size = small_size * (63 + random() % 4) + random() % (small_size + 1); break;
+            default: large_size = small_size + random() % 2000;
+        }
+        size_t const common = random() % (small_size + 1);
+
+        // Distinct hashes: the first `common` go into both sketches, the others into one of them.
+        std::set<uint64_t> distinct{};
+        while (distinct.size() < small_size + large_size - common)
+            distinct.insert(random() % 2 ? random() : random() % (4 * (small_size + large_size)));
+        std::vector<uint64_t> values(distinct.begin(), distinct.end());
+        std::ranges::shuffle(values, random);
+
+        std::vector<uint64_t> small(values.begin(), values.begin() + small_size);
+        std::vector<uint64_t> large(values.begin(), values.begin() + common);
+        large.insert(large.end(), values.begin() + small_size, values.end());
+        std::ranges::sort(small);
+        std::ranges::sort(large);
+
+        bool equal = seqan3::intersection_count(small, large) == common &&
+                     seqan3::intersection_count(large, small) == common &&
+                     seqan3::detail::merge_intersection_count(small, large) == common &&
+                     seqan3::detail::merge_intersection_count(large, small) == common &&
+                     seqan3::detail::galloping_intersection_count(small, large) == common;
+#if SEQAN3_SKETCH_DISTANCE_AVX2
+        if (seqan3::detail::has_avx2())
+            equal &= seqan3::detail::avx2_intersection_count(small, large) == common &&
+                     seqan3::detail::avx2_intersection_count(large, small) == common;
+#endif
+        count_round(counts, "intersection_count", equal,
+                    std::to_string(small_size) + " and " + std::to_string(large_size) + " hashes with " +
+                    std::to_string(common) + " in common");
+    }
+    return report("intersection_count", counts);
+}
+
+bool run_program(equivalence_check_arguments const & args)
+{
+    std::mt19937_64 random{args.seed};
+
+    bool passed{true};
+    std::cout << "case,rounds,mismatches\n";
+
+    passed &= check_multi_seed_syncmer<seqan3::closed_syncmer_offsets>("multi_seed_syncmer_hash", args, random,
+        [] (auto const & sequence, size_t const smers, size_t const kmers, seqan3::seed const seed)
+    {
+        return sequence | syncmer_hash(smers, kmers, seed);
+    });
+    passed &= check_multi_seed_syncmer<seqan3::open_syncmer_offsets>("multi_seed_opensyncmer_hash", args, random,
+        [] (auto const & sequence, size_t const smers, size_t const kmers, seqan3::seed const seed)
+    {
+        return sequence | opensyncmer_hash(smers, kmers, seed);
+    });
+    passed &= check_multi_seed_minimiser(args, random);
+
+    passed &= check_sketcher("syncmer_sketcher", args, random,
+                             syncmer_sketcher_case<seqan3::closed_syncmer_offsets>(
+        [] (auto const & sequence, size_t const smers, size_t const kmers, seqan3::seed const seed)
+    {
+        return sequence | syncmer_hash(smers, kmers, seed);
+    }));
+    passed &= check_sketcher("opensyncmer_sketcher", args, random,
+                             syncmer_sketcher_case<seqan3::open_syncmer_offsets>(
+        [] (auto const & sequence, size_t const smers, size_t const kmers, seqan3::seed const seed)
+    {
+        return sequence | opensyncmer_hash(smers, kmers, seed);
+    }));
+    passed &= check_sketcher("minimiser_sketcher", args, random, [] (std::mt19937_64 & random)
+    {
+        size_t const shape_size = 1 + random() % 32;
+        size_t const window = shape_size + random() % 40;
+        seqan3::shape const shape{seqan3::ungapped{static_cast<uint8_t>(shape_size)}};
+        seqan3::window_size const window_size{static_cast<uint32_t>(window)};
+        seqan3::seed const seed{random() % 2 ? 0x8F3F73B5CF1C9ADE : random()};
+        auto const expected = [=] (std::vector<seqan3::dna4> const & sequence)
+        {
+            return collect(sequence | seqan3::views::minimiser_hash(shape, window_size, seed));
+        };
+        // Sequences shorter than the window have one minimiser, unless they are shorter than the shape.
+        return std::tuple{seqan3::minimiser_sketcher{shape, window_size, seed}, expected, shape_size,
+                          "shape size " + std::to_string(shape_size) + ", window " + std::to_string(window)};
+    });
+
+    passed &= check_intersection_count(args, random);
+
+    return passed;
+}
+
+void initialise_argument_parser(seqan3::argument_parser & parser, equivalence_check_arguments & args)
+{
+    parser.info.short_description = "Checks that the multi-seed hashes and the streaming sketchers give the same "
+                                    "hashes as the sampling views, and that the intersection kernels agree.";
+    parser.info.description.push_back("Returns 1 if any case differs from its reference.");
+
+    parser.add_option(args.rounds, 'n', "rounds", "The number of random sequences per case.",
+                      seqan3::option_spec::standard, seqan3::arithmetic_range_validator{1, 1'000'000});
+    parser.add_option(args.max_length, 'l', "max-length", "The largest number of bases of a random sequence.",
+                      seqan3::option_spec::standard, seqan3::arithmetic_range_validator{1, 1'000'000});
+    parser.add_option(args.seed, 'r', "random-seed", "The seed of the random sequences and parameters.",
+                      seqan3::option_spec::standard);
+}
+
+int main(int argc, char ** argv)
+{
+    seqan3::argument_parser parser{"equivalence_check", argc, argv};
+    equivalence_check_arguments args{};
+    initialise_argument_parser(parser, args);
+
+    try
+    {
+        parser.parse();
+    }
+    catch (seqan3::argument_parser_error const & ext)
+    {
+        std::cerr << "[Error] " << ext.what() << '\n';
+        return -1;
+    }
+
+    return run_program(args) ? 0 : 1;
+}
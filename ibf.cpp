@@ -0,0 +1,238 @@
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include <seqan3/alphabet/nucleotide/dna4.hpp>
+#include <seqan3/argument_parser/all.hpp>
+#include <seqan3/search/views/mapped_sequence_file.hpp>
+#include <seqan3/search/views/minimiser_hash.hpp>
+#include <seqan3/search/views/opensyncmer_hash.hpp>
+#include <seqan3/search/views/profiler.hpp>
+#include <seqan3/search/views/record_pipeline.hpp>
+#include <seqan3/search/views/sketch_ibf.hpp>
+#include <seqan3/search/views/syncmer_hash.hpp>
+
+/* Builds an interleaved Bloom filter with one bin per reference file and assigns reads to the bins.
+ *
+ * The bin size is chosen for the given false positive rate from the largest number of distinct hashes of a bin, so
+ * the size of the filter shows how many hashes a sampling scheme needs. Query file i contains reads of reference
+ * file i; a read is assigned to every bin containing at least `threshold` of its hashes. One CSV line
+ * "kmer,smer,max_bin_hashes,ibf_bytes,sensitivity,false_positives" is written, where sensitivity is the fraction of
+ * reads assigned to their own bin and false_positives the number of assignments to other bins. Comparing the lines of
+ * syncmer and minimiser runs at equal sensitivity compares the filter sizes.
+ *
+ * For minimiser, kmer is the window size and smer the shape size. --profile and --trace write the time of building
+ * (stage ibf_fill, per bin) and counting (stage ibf_count, per batch of reads), see seqan3::profiler. Input files may
+ * be gzip or BGZF compressed.
+ */
+
+struct ibf_arguments
+{
+    std::string method{"syncmer"};
+    size_t kmer{};
+    size_t smer{};
+    std::vector<std::filesystem::path> references{};
+    std::vector<std::filesystem::path> queries{};
+    double fpr{0.05};
+    size_t hash_functions{2};
+    double threshold{0.5};
+    std::filesystem::path output{};
+    size_t threads{1};
+    std::filesystem::path profile{};
+    std::filesystem::path trace{};
+};
+
+// Calls `callback` with every hash of the method on a sequence; sequences shorter than a k-mer have none.
+template <typename sequence_t, typename callback_t>
+void for_each_hash(ibf_arguments const & args, sequence_t && sequence, callback_t && callback)
+{
+    if (static_cast<size_t>(std::ranges::distance(sequence)) < args.kmer)
+        return;
+
+    if (args.method == "syncmer")
+    {
+        for (uint64_t const hash : sequence | syncmer_hash(args.smer, args.kmer))
+            callback(hash);
+    }
+    else if (args.method == "opensyncmer")
+    {
+        for (uint64_t const hash : sequence | opensyncmer_hash(args.smer, args.kmer))
+            callback(hash);
+    }
+    else
+    {
+        for (uint64_t const hash : sequence | seqan3::views::minimiser_hash(
+                                                  seqan3::shape{seqan3::ungapped{static_cast<uint8_t>(args.smer)}},
+                                                  seqan3::window_size{static_cast<uint32_t>(args.kmer)}))
+            callback(hash);
+    }
+}
+
+// Calls `callback` with every record of a file in file order; compressed files are read by a seqan3::record_pipeline.
+template <typename callback_t>
+void for_each_record(std::filesystem::path const & path, callback_t && callback)
+{
+    if (seqan3::record_pipeline<seqan3::dna4>::is_compressed(path))
+        seqan3::record_pipeline<seqan3::dna4>{path}.run([&callback] (auto const & record, size_t) { callback(record); });
+    else
+        for (auto const & record : seqan3::mapped_sequence_file<seqan3::dna4>{path})
+            callback(record);
+}
+
+// Calls `callback` with every hash of the method on every sequence of a file.
+template <typename callback_t>
+void for_each_file_hash(ibf_arguments const & args, std::filesystem::path const & path, callback_t && callback)
+{
+    for_each_record(path, [&] (auto const & record) { for_each_hash(args, record.sequence(), callback); });
+}
+
+void run_program(ibf_arguments const & args)
+{
+    seqan3::profiler & profiler = seqan3::profiler::global();
+    if (!args.profile.empty() || !args.trace.empty())
+        profiler.enable(!args.trace.empty());
+
+    size_t const bin_count = args.references.size();
+
+    // The number of distinct hashes of every bin determines the bin size.
+    std::vector<size_t> bin_hashes(bin_count);
+    seqan3::detail::ibf_parallel_for(args.threads, bin_count, [&] (size_t const bin, size_t)
+    {
+        std::vector<uint64_t> hashes{};
+        for_each_file_hash(args, args.references[bin], [&hashes] (uint64_t const hash) { hashes.push_back(hash); });
+        std::ranges::sort(hashes);
+        bin_hashes[bin] = std::unique(hashes.begin(), hashes.end()) - hashes.begin();
+    });
+
+    size_t const max_bin_hashes = std::ranges::max(bin_hashes);
+    size_t const bin_size = seqan3::ibf_bin_size(max_bin_hashes, args.hash_functions, args.fpr);
+    seqan3::interleaved_bloom_filter<> const ibf = seqan3::build_ibf(bin_count, bin_size, args.hash_functions,
+                                                                     args.threads, [&] (size_t const bin, auto && insert)
+    {
+        for_each_file_hash(args, args.references[bin], insert);
+    });
+
+    std::vector<std::vector<uint64_t>> reads{};
+    std::vector<size_t> origins{};
+    for (size_t origin = 0; origin < args.queries.size(); ++origin)
+    {
+        for_each_record(args.queries[origin], [&] (auto const & record)
+        {
+            reads.emplace_back();
+            origins.push_back(origin);
+            for_each_hash(args, record.sequence(), [&reads] (uint64_t const hash) { reads.back().push_back(hash); });
+        });
+    }
+
+    std::atomic<size_t> true_positives{0};
+    std::atomic<size_t> false_positives{0};
+    seqan3::count_ibf(ibf, reads, args.threads, [&] (size_t const read, auto const & counts)
+    {
+        if (reads[read].empty())
+            return;
+
+        size_t const needed = static_cast<size_t>(std::ceil(args.threshold * reads[read].size()));
+        for (size_t bin = 0; bin < bin_count; ++bin)
+        {
+            if (counts[bin] < needed)
+                continue;
+            if (bin == origins[read])
+                ++true_positives;
+            else
+                ++false_positives;
+        }
+    });
+
+    std::ofstream out{args.output};
+    out << args.kmer << ',' << args.smer << ',' << max_bin_hashes << ',' << ibf.bit_size() / 8 << ','
+        << (reads.empty() ? 0.0 : static_cast<double>(true_positives) / reads.size()) << ','
+        << false_positives << '\n';
+
+    if (!args.profile.empty())
+    {
+        std::ofstream profile{args.profile};
+        profiler.write_json(profile);
+    }
+    if (!args.trace.empty())
+    {
+        std::ofstream trace{args.trace};
+        profiler.write_chrome_trace(trace);
+    }
+}
+
+void initialise_argument_parser(seqan3::argument_parser & parser, ibf_arguments & args)
+{
+    parser.info.short_description = "Builds an interleaved Bloom filter of sampled hashes and assigns reads to bins.";
+    parser.info.description.push_back("Query file i contains reads of reference file i. Writes one CSV line "
+                                      "kmer,smer,max_bin_hashes,ibf_bytes,sensitivity,false_positives.");
+
+    parser.add_option(args.method, 'm', "method", "The sampling method.", seqan3::option_spec::standard,
+                      seqan3::value_list_validator{"syncmer", "opensyncmer", "minimiser"});
+    parser.add_option(args.kmer, 'k', "kmer", "The k-mer size, or the window size for minimiser.",
+                      seqan3::option_spec::required, seqan3::arithmetic_range_validator{2, 32});
+    parser.add_option(args.smer, 's', "smer", "The s-mer size, or the shape size for minimiser.",
+                      seqan3::option_spec::required, seqan3::arithmetic_range_validator{1, 31});
+    parser.add_option(args.references, 'r', "reference", "A reference file, one bin per file.",
+                      seqan3::option_spec::required, seqan3::input_file_validator{});
+    parser.add_option(args.queries, 'q', "query", "The reads of the reference with the same index.",
+                      seqan3::option_spec::standard, seqan3::input_file_validator{});
+    parser.add_option(args.fpr, 'f', "fpr", "The false positive rate of a single lookup.",
+                      seqan3::option_spec::standard, seqan3::arithmetic_range_validator{0.0001, 0.5});
+    parser.add_option(args.hash_functions, 'n', "hash-functions", "The number of hash functions.",
+                      seqan3::option_spec::standard, seqan3::arithmetic_range_validator{1, 5});
+    parser.add_option(args.threshold, 't', "threshold", "The minimum fraction of hashes of a read in a bin.",
+                      seqan3::option_spec::standard, seqan3::arithmetic_range_validator{0.0, 1.0});
+    parser.add_option(args.output, 'o', "output", "The CSV file to write.", seqan3::option_spec::required);
+    parser.add_option(args.threads, 'j', "threads", "The number of threads.", seqan3::option_spec::standard,
+                      seqan3::arithmetic_range_validator{1, 1024});
+    parser.add_option(args.profile, 'p', "profile", "Write the time per stage as JSON to the given file.",
+                      seqan3::option_spec::standard);
+    parser.add_option(args.trace, 'e', "trace", "Write a Chrome trace of all timed calls to the given file.",
+                      seqan3::option_spec::standard);
+}
+
+int main(int argc, char ** argv)
+{
+    seqan3::argument_parser parser{"ibf", argc, argv};
+    ibf_arguments args{};
+    initialise_argument_parser(parser, args);
+
+    try
+    {
+        parser.parse();
+
+        if (args.smer >= args.kmer)
+            throw seqan3::argument_parser_error{"Please choose an s-mer size smaller than the k-mer size."};
+
+        if (!args.queries.empty() && args.queries.size() != args.references.size())
+            throw seqan3::argument_parser_error{"Please give one query file per reference file."};
+    }
+    catch (seqan3::argument_parser_error const & ext)
+    {
+        std::cerr << "[Error] " << ext.what() << '\n';
+        return -1;
+    }
+
+    try
+    {
+        run_program(args);
+    }
+    catch (std::invalid_argument const & ext) // The bin size of the chosen false positive rate.
+    {
+        std::cerr << "[Error] " << ext.what() << '\n';
+        return -1;
+    }
+    catch (seqan3::file_open_error const & ext)
+    {
+        std::cerr << "[Error] " << ext.what() << '\n';
+        return -1;
+    }
+    catch (seqan3::format_error const & ext)
+    {
+        std::cerr << "[Error] " << ext.what() << '\n';
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,222 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Hossein Eizadi Moghadam <hosseinem AT fu-berlin.de>
+ * \brief Provides seqan3::bucket_writer and seqan3::read_bucket.
+ */
+
+#pragma once
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <seqan3/alphabet/concept.hpp>
+#include <seqan3/io/exception.hpp>
+#include "shared.hpp"
+#include "superkmer.hpp"
+
+namespace seqan3
+{
+/*!\brief Distributes sequences to a fixed number of on-disk buckets.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * Every bucket has an in-memory buffer; a buffer is appended to the bucket file `<prefix>.<id>.bucket` when it exceeds
+ * `buffer_size` bytes and when the writer is flushed or destroyed. A record is the 32 bit length of the sequence
+ * followed by its ranks packed with 2 bits per character, so only alphabets of size 4 or less are supported.
+ *
+ * Because superkmers (seqan3::views::superkmer_hash) are routed by their minimiser, every k-mer of the input ends up
+ * in exactly one bucket and all occurrences of a k-mer end up in the same bucket. The buckets can therefore be
+ * counted or indexed one at a time, or in parallel by separate threads or processes, with seqan3::read_bucket.
+ *
+ * A writer is not thread-safe, use one writer with a distinct prefix per thread.
+ */
+class bucket_writer
+{
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    bucket_writer() = delete; //!< Deleted.
+    bucket_writer(bucket_writer const &) = delete; //!< Deleted.
+    bucket_writer(bucket_writer &&) = default; //!< Defaulted.
+    bucket_writer & operator=(bucket_writer const &) = delete; //!< Deleted.
+    bucket_writer & operator=(bucket_writer &&) = default; //!< Defaulted.
+
+    //!\brief Flushes all buffers; errors are ignored, call flush() before to observe them.
+    ~bucket_writer()
+    {
+        try
+        {
+            flush();
+        }
+        catch (...)
+        {}
+    }
+
+    /*!\brief Construct from a file prefix and the number of buckets; creates or truncates all bucket files.
+     * \param[in] prefix       The path prefix of the bucket files.
+     * \param[in] bucket_count The number of buckets.
+     * \param[in] buffer_size  The number of bytes buffered per bucket before it is written. Default: 1 MiB.
+     * \throws std::invalid_argument if `bucket_count` is 0.
+     * \throws seqan3::file_open_error if a bucket file cannot be created.
+     */
+    bucket_writer(std::filesystem::path prefix, size_t const bucket_count, size_t const buffer_size = 1u << 20) :
+        prefix{std::move(prefix)},
+        buffers(bucket_count),
+        buffer_size{buffer_size}
+    {
+        if (bucket_count == 0)
+            throw std::invalid_argument{"The chosen bucket_count is not valid. Please choose a value greater than 0."};
+
+        for (size_t id = 0; id < bucket_count; ++id)
+        {
+            std::ofstream file{bucket_path(id), std::ios::binary | std::ios::trunc};
+            if (!file)
+                throw file_open_error{"Could not create the bucket file " + bucket_path(id).string() + "."};
+        }
+    }
+    //!\}
+
+    //!\brief The number of buckets.
+    size_t bucket_count() const noexcept
+    {
+        return buffers.size();
+    }
+
+    //!\brief The path of the file of bucket `id`.
+    std::filesystem::path bucket_path(size_t const id) const
+    {
+        return prefix.string() + "." + std::to_string(id) + ".bucket";
+    }
+
+    /*!\brief The bucket of a hash value, e.g. the minimiser of a superkmer.
+     * \details The bucket is given by the prefix of the mixed hash, `(mix_hash(hash) * bucket_count) / 2^64`, which is
+     *          a plain bit prefix if the number of buckets is a power of two.
+     */
+    size_t bucket_of(uint64_t const hash) const noexcept
+    {
+        return static_cast<size_t>((static_cast<unsigned __int128>(mix_hash(hash)) * buffers.size()) >> 64);
+    }
+
+    /*!\brief Appends a sequence to a bucket.
+     * \param[in] id       The bucket.
+     * \param[in] sequence The sequence, its characters must model seqan3::semialphabet with at most 4 values.
+     * \throws std::ios_base::failure if the bucket buffer is full and cannot be written.
+     */
+    template <std::ranges::forward_range rng_t>
+    void push(size_t const id, rng_t && sequence)
+    {
+        using alphabet_t = std::ranges::range_value_t<rng_t>;
+        static_assert(semialphabet<alphabet_t>, "The sequence must be over elements of seqan3::semialphabet.");
+        static_assert(alphabet_size<alphabet_t> <= 4, "Only alphabets of size 4 or less can be stored in a bucket.");
+
+        std::vector<uint8_t> & buffer = buffers[id];
+        size_t const record_start = buffer.size();
+        buffer.resize(record_start + sizeof(uint32_t));
+
+        uint32_t length{0};
+        uint8_t packed{0};
+        for (auto const character : sequence)
+        {
+            packed |= static_cast<uint8_t>(seqan3::to_rank(character)) << (2 * (length & 3u));
+            if ((++length & 3u) == 0)
+            {
+                buffer.push_back(packed);
+                packed = 0;
+            }
+        }
+        if (length & 3u)
+            buffer.push_back(packed);
+
+        std::memcpy(buffer.data() + record_start, &length, sizeof(uint32_t));
+
+        if (buffer.size() >= buffer_size)
+            flush(id);
+    }
+
+    /*!\brief Appends the characters of a superkmer to the bucket of its minimiser.
+     * \param[in] text      The text the superkmer was computed on.
+     * \param[in] superkmer The superkmer, e.g. an element of seqan3::views::superkmer_hash.
+     */
+    template <std::ranges::forward_range rng_t>
+    void push(rng_t && text, superkmer const & superkmer)
+    {
+        push(bucket_of(superkmer.minimiser), std::forward<rng_t>(text) | std::views::drop(superkmer.start)
+                                                                      | std::views::take(superkmer.length));
+    }
+
+    /*!\brief Appends the buffer of one bucket to its file.
+     * \throws std::ios_base::failure if the bucket file cannot be written.
+     */
+    void flush(size_t const id)
+    {
+        std::vector<uint8_t> & buffer = buffers[id];
+        if (buffer.empty())
+            return;
+
+        std::ofstream file{bucket_path(id), std::ios::binary | std::ios::app};
+        file.exceptions(std::ios::badbit | std::ios::failbit);
+        file.write(reinterpret_cast<char const *>(buffer.data()), buffer.size());
+        buffer.clear();
+    }
+
+    //!\brief Appends the buffers of all buckets to their files.
+    void flush()
+    {
+        for (size_t id = 0; id < buffers.size(); ++id)
+            flush(id);
+    }
+
+private:
+    //!\brief The path prefix of the bucket files.
+    std::filesystem::path prefix{};
+    //!\brief One buffer of encoded records per bucket.
+    std::vector<std::vector<uint8_t>> buffers{};
+    //!\brief The number of bytes after which a buffer is written.
+    size_t buffer_size{};
+};
+
+/*!\brief Calls `callback` with every sequence stored in a bucket file written by seqan3::bucket_writer.
+ * \tparam alphabet_t The alphabet the sequences are decoded to, e.g. seqan3::dna4.
+ * \param[in] path     The bucket file.
+ * \param[in] callback Called with a `std::span<alphabet_t const>` per record; the span is only valid during the call.
+ * \throws seqan3::file_open_error if the file cannot be opened.
+ * \throws seqan3::format_error if the file ends inside a record.
+ * \ingroup search_views
+ */
+template <semialphabet alphabet_t, typename callback_t>
+void read_bucket(std::filesystem::path const & path, callback_t && callback)
+{
+    std::ifstream file{path, std::ios::binary};
+    if (!file)
+        throw file_open_error{"Could not open the bucket file " + path.string() + "."};
+
+    std::vector<uint8_t> packed{};
+    std::vector<alphabet_t> sequence{};
+    uint32_t length{};
+
+    while (file.read(reinterpret_cast<char *>(&length), sizeof(uint32_t)))
+    {
+        packed.resize((length + 3u) / 4u);
+        if (!file.read(reinterpret_cast<char *>(packed.data()), packed.size()))
+            throw format_error{"The bucket file " + path.string() + " ends inside a record."};
+
+        sequence.resize(length);
+        for (uint32_t i = 0; i < length; ++i)
+            seqan3::assign_rank_to((packed[i >> 2] >> (2 * (i & 3u))) & 3u, sequence[i]);
+
+        callback(std::span<alphabet_t const>{sequence});
+    }
+}
+} // namespace seqan3
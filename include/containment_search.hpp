@@ -0,0 +1,237 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Hossein Eizadi Moghadam <hosseinem AT fu-berlin.de>
+ * \brief Provides seqan3::containment_search.
+ */
+
+#pragma once
+
+#include <seqan3/std/algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "position_index.hpp"
+
+namespace seqan3
+{
+/*!\brief A pair of a query and a reference sketch with a large containment.
+ * \ingroup search_views
+ */
+struct containment_hit
+{
+    //!\brief The index of the query sketch.
+    uint32_t query{};
+    //!\brief The index of the reference sketch.
+    uint32_t reference{};
+    //!\brief The number of hashes of the query that are in the reference.
+    uint32_t shared{};
+    //!\brief The fraction of the hashes of the query that are in the reference.
+    double containment{};
+
+    //!\brief Compares all members.
+    friend bool operator==(containment_hit const &, containment_hit const &) = default;
+};
+
+/*!\brief Finds all pairs of query and reference sketches, e.g. of syncmer_hash or minimiser_hash, whose containment
+ *        exceeds a threshold.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * Comparing every query with every reference takes O(N M L) time for N queries and M references of L hashes. Instead,
+ * the references are split into tiles of `tile_size` consecutive references, and every tile gets an inverted index from
+ * hash to the references of the tile containing it, a seqan3::position_index whose positions are the reference
+ * indices within the tile. A query then only touches the references it shares hashes with: its hashes are looked up in
+ * the index and a counter per reference of the tile is incremented for every hit.
+ *
+ * The work is split into tasks of a block of `query_block` queries and one tile, which run on a pool of threads. The
+ * index of a tile and the counters of a thread, `tile_size` 32 bit integers, stay in the cache while a block of queries
+ * is processed; the tasks of one tile are handed out consecutively, so the threads share the tile in the last level
+ * cache.
+ *
+ * The sketches must not contain duplicate hashes, e.g. they are decoded from a seqan3::sketch_file.
+ */
+class containment_search
+{
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    containment_search() = default; //!< Defaulted.
+    containment_search(containment_search const &) = default; //!< Defaulted.
+    containment_search(containment_search &&) = default; //!< Defaulted.
+    containment_search & operator=(containment_search const &) = default; //!< Defaulted.
+    containment_search & operator=(containment_search &&) = default; //!< Defaulted.
+    ~containment_search() = default; //!< Defaulted.
+
+    /*!\brief Builds the indices of the reference tiles.
+     * \param[in] references The reference sketches.
+     * \param[in] threads    The number of threads building the indices. Default: 1.
+     * \param[in] tile_size  The number of references per tile. Default: 4096.
+     * \throws std::invalid_argument if `tile_size` or `threads` is 0.
+     */
+    explicit containment_search(std::span<std::vector<uint64_t> const> references,
+                                size_t const threads = 1,
+                                size_t const tile_size = 4096)
+    {
+        if (tile_size == 0)
+            throw std::invalid_argument{"The chosen tile_size is not valid. Please choose a value greater than 0."};
+
+        if (threads == 0)
+            throw std::invalid_argument{"The chosen number of threads is not valid. Please choose a value greater than 0."};
+
+        for (size_t first = 0; first < references.size(); first += tile_size)
+            tiles.push_back({first, std::min(tile_size, references.size() - first), {}});
+
+        parallel_for(threads, tiles.size(), [&] (size_t const id)
+        {
+            tile & current = tiles[id];
+            std::vector<std::pair<uint64_t, position_index::position_type>> pairs{};
+            for (size_t local = 0; local < current.size; ++local)
+                for (uint64_t const hash : references[current.first + local])
+                    pairs.emplace_back(hash, static_cast<position_index::position_type>(local));
+
+            current.index = position_index{pairs};
+        });
+
+        reference_count = references.size();
+    }
+    //!\}
+
+    //!\brief The number of reference sketches.
+    size_t size() const noexcept
+    {
+        return reference_count;
+    }
+
+    //!\brief The number of bytes of the indices.
+    size_t size_in_bytes() const noexcept
+    {
+        size_t bytes{0};
+        for (tile const & current : tiles)
+            bytes += current.index.size_in_bytes();
+        return bytes;
+    }
+
+    /*!\brief Returns all pairs of a query and a reference with a containment of at least `threshold`.
+     * \param[in] queries     The query sketches.
+     * \param[in] threshold   The minimal fraction of the hashes of a query that are in a reference.
+     * \param[in] threads     The number of threads. Default: 1.
+     * \param[in] query_block The number of queries per task. Default: 64.
+     * \returns The hits sorted by query and reference. Pairs without shared hashes are never reported, and neither are
+     *          empty queries.
+     * \throws std::invalid_argument if `threshold` is not in [0, 1] or `threads` or `query_block` is 0.
+     */
+    std::vector<containment_hit> search(std::span<std::vector<uint64_t> const> queries,
+                                        double const threshold,
+                                        size_t const threads = 1,
+                                        size_t const query_block = 64) const
+    {
+        if (threshold < 0.0 || threshold > 1.0)
+            throw std::invalid_argument{"The chosen threshold is not valid. Please choose a value in [0, 1]."};
+
+        if (threads == 0 || query_block == 0)
+            throw std::invalid_argument{"The chosen number of threads and query_block are not valid. "
+                                        "Please choose values greater than 0."};
+
+        size_t const block_count = (queries.size() + query_block - 1) / query_block;
+        std::vector<containment_hit> hits{};
+        std::mutex hits_mutex{};
+
+        // Tasks are ordered by tile, so that consecutive tasks share the index of their tile.
+        parallel_for(threads, block_count * tiles.size(), [&] (size_t const task)
+        {
+            thread_local std::vector<uint32_t> counts{};
+            thread_local std::vector<position_index::position_type> positions{};
+            thread_local std::vector<size_t> offsets{};
+            std::vector<containment_hit> found{};
+
+            tile const & current = tiles[task / block_count];
+            size_t const first_query = task % block_count * query_block;
+            size_t const last_query = std::min(first_query + query_block, queries.size());
+            counts.assign(current.size, 0);
+
+            for (size_t query = first_query; query < last_query; ++query)
+            {
+                std::vector<uint64_t> const & hashes = queries[query];
+                if (hashes.empty())
+                    continue;
+
+                current.index.locate(hashes, positions, offsets);
+                for (position_index::position_type const local : positions)
+                    ++counts[local];
+
+                // A reference is reported once, when its counter is read first; then it is reset.
+                for (position_index::position_type const local : positions)
+                {
+                    if (counts[local] == 0)
+                        continue;
+
+                    double const fraction = static_cast<double>(counts[local]) / hashes.size();
+                    if (fraction >= threshold)
+                        found.push_back({static_cast<uint32_t>(query),
+                                         static_cast<uint32_t>(current.first + local),
+                                         counts[local],
+                                         fraction});
+                    counts[local] = 0;
+                }
+            }
+
+            std::lock_guard lock{hits_mutex};
+            hits.insert(hits.end(), found.begin(), found.end());
+        });
+
+        std::ranges::sort(hits, [] (containment_hit const & lhs, containment_hit const & rhs)
+        {
+            return std::tie(lhs.query, lhs.reference) < std::tie(rhs.query, rhs.reference);
+        });
+
+        return hits;
+    }
+
+private:
+    //!\brief The index of consecutive references.
+    struct tile
+    {
+        //!\brief The first reference of the tile.
+        size_t first{};
+        //!\brief The number of references of the tile.
+        size_t size{};
+        //!\brief The references of every hash, relative to `first`.
+        position_index index{};
+    };
+
+    //!\brief The tiles of the references.
+    std::vector<tile> tiles{};
+    //!\brief The number of references.
+    size_t reference_count{};
+
+    //!\brief Calls `function(task)` for every task in `[0, count)` on a pool of `threads` threads, in increasing order.
+    template <typename function_t>
+    static void parallel_for(size_t const threads, size_t const count, function_t && function)
+    {
+        std::atomic<size_t> next{0};
+        auto worker = [&] ()
+        {
+            for (size_t task = next++; task < count; task = next++)
+                function(task);
+        };
+
+        std::vector<std::jthread> workers{};
+        for (size_t thread = 1; thread < threads; ++thread)
+            workers.emplace_back(worker);
+        worker();
+    }
+};
+} // namespace seqan3
@@ -0,0 +1,299 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Hossein Eizadi Moghadam <hosseinem AT fu-berlin.de>
+ * \brief Provides seqan3::hash_counter.
+ */
+
+#pragma once
+
+#include <seqan3/std/algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "shared.hpp"
+
+namespace seqan3
+{
+/*!\brief Counts the occurrences of hash values, e.g. of seqan3::views::syncmer_hash, from several threads at once.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * The counter is an open-addressing table of a fixed capacity. A table block is one cache line of seven mixed hashes
+ * (mix_hash) and their counts; a hash is placed in the block given by the prefix of its mixed value or, if that block
+ * is full, in one of the following blocks. Slots are claimed with a compare-and-swap and counts are incremented with a
+ * compare-and-swap loop, so insert() is lock-free and can be called concurrently. Counts saturate at 255.
+ *
+ * Most distinct hashes of sequencing data occur only once, e.g. because of sequencing errors. With a prefilter of
+ * `prefilter_bytes` > 0, a hash is only put into the table once a blocked count-min sketch has seen it
+ * `prefilter_threshold` times; its count then starts at that estimate. The table then only needs a capacity for the
+ * hashes that are not filtered, which keeps the memory bounded on large data. A count-min sketch never
+ * underestimates, so no hash with at least `prefilter_threshold` occurrences is lost, but the counts of the hashes in
+ * the table are upper bounds that are exact if their prefilter counters have no collisions.
+ */
+class hash_counter
+{
+public:
+    //!\brief The largest count, larger counts are saturated to this value.
+    static constexpr size_t max_count{std::numeric_limits<uint8_t>::max()};
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    hash_counter() = delete; //!< Deleted.
+    hash_counter(hash_counter const &) = delete; //!< Deleted.
+    hash_counter(hash_counter &&) = default; //!< Defaulted.
+    hash_counter & operator=(hash_counter const &) = delete; //!< Deleted.
+    hash_counter & operator=(hash_counter &&) = default; //!< Defaulted.
+    ~hash_counter() = default; //!< Defaulted.
+
+    /*!\brief Construct with a capacity and an optional prefilter.
+     * \param[in] capacity            The maximal number of distinct hashes in the table.
+     * \param[in] prefilter_bytes     The size of the count-min prefilter, 0 disables it. Default: 0.
+     * \param[in] prefilter_threshold The number of occurrences after which a hash enters the table. Default: 2.
+     * \throws std::invalid_argument if `capacity` is 0 or `prefilter_threshold` is not in [2, 255].
+     */
+    explicit hash_counter(size_t const capacity,
+                          size_t const prefilter_bytes = 0,
+                          size_t const prefilter_threshold = 2) :
+        block_count{std::max<size_t>(1, (capacity * 8 / 7 + slots_per_block - 1) / slots_per_block)},
+        blocks{std::make_unique<block[]>(block_count)},
+        line_count{(prefilter_bytes + sizeof(block) - 1) / sizeof(block)},
+        prefilter{std::make_unique<block[]>(line_count)},
+        prefilter_threshold{prefilter_threshold}
+    {
+        if (capacity == 0)
+            throw std::invalid_argument{"The chosen capacity is not valid. Please choose a value greater than 0."};
+
+        if (prefilter_threshold < 2 || prefilter_threshold > max_count)
+            throw std::invalid_argument{"The chosen prefilter_threshold is not valid. "
+                                        "Please choose a value in [2, 255]."};
+    }
+    //!\}
+
+    /*!\brief Counts one occurrence of a hash. Thread-safe.
+     * \returns False, if the hash is not in the table and the table is full; the occurrence is then lost.
+     */
+    bool insert(uint64_t const hash) noexcept
+    {
+        uint64_t const key = mix_hash(hash);
+        uint8_t initial{1}; // The count of a hash that enters the table.
+
+        if (line_count != 0)
+        {
+            initial = prefilter_insert(key);
+            if (initial < prefilter_threshold)
+                return true;
+        }
+
+        if (key == 0) // The key 0 marks empty slots, the hash with mixed value 0 has its own counter.
+        {
+            saturating_add(zero_count, 1, initial);
+            return true;
+        }
+
+        for (size_t probe = 0, id = home_block(key); probe < block_count; ++probe, id = next_block(id))
+        {
+            block & current = blocks[id];
+            for (size_t slot = 0; slot < slots_per_block; ++slot)
+            {
+                std::atomic_ref<uint64_t> slot_key{current.keys[slot]};
+                uint64_t found = slot_key.load(std::memory_order_relaxed);
+
+                if (found == 0 && slot_key.compare_exchange_strong(found, key, std::memory_order_relaxed))
+                {
+                    saturating_add(current.counts[slot], initial);
+                    return true;
+                }
+
+                if (found == key)
+                {
+                    saturating_add(current.counts[slot], 1);
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    /*!\brief Counts all hashes of a range, e.g. the result of seqan3::views::syncmer_hash. Thread-safe.
+     * \returns The number of occurrences that were lost because the table is full.
+     */
+    template <std::ranges::input_range rng_t>
+    size_t insert(rng_t && hashes) noexcept
+    {
+        size_t lost{0};
+        for (uint64_t const hash : hashes)
+            lost += !insert(hash);
+        return lost;
+    }
+
+    /*!\brief The count of a hash, 0 if it is not in the table. Only exact once all insertions have finished.
+     */
+    size_t count(uint64_t const hash) const noexcept
+    {
+        uint64_t const key = mix_hash(hash);
+        if (key == 0)
+            return zero_count;
+
+        for (size_t probe = 0, id = home_block(key); probe < block_count; ++probe, id = next_block(id))
+        {
+            block const & current = blocks[id];
+            for (size_t slot = 0; slot < slots_per_block; ++slot)
+            {
+                if (current.keys[slot] == key)
+                    return current.counts[slot];
+                if (current.keys[slot] == 0)
+                    return 0;
+            }
+        }
+
+        return 0;
+    }
+
+    /*!\brief Returns all hashes whose count is in `[min_count, max_count]`, in no particular order.
+     * \param[in] min_count The smallest count that is kept.
+     * \param[in] max_count The largest count that is kept; saturated counts are 255. Default: no upper bound.
+     * \param[in] threads   The number of threads scanning the table. Default: 1.
+     *
+     * \details
+     *
+     * Must not run concurrently with insert(). Every thread scans a contiguous range of blocks.
+     */
+    std::vector<uint64_t> filter_by_cutoff(size_t const min_count,
+                                           size_t const max_count = std::numeric_limits<size_t>::max(),
+                                           size_t const threads = 1) const
+    {
+        auto const keep = [min_count, max_count] (uint8_t const count)
+        {
+            return count != 0 && count >= min_count && count <= max_count;
+        };
+
+        std::vector<std::vector<uint64_t>> thread_hashes(std::max<size_t>(threads, 1));
+        {
+            std::vector<std::jthread> workers{};
+            for (size_t thread = 0; thread < thread_hashes.size(); ++thread)
+            {
+                workers.emplace_back([&, thread] ()
+                {
+                    size_t const first = block_count * thread / thread_hashes.size();
+                    size_t const last = block_count * (thread + 1) / thread_hashes.size();
+                    for (size_t id = first; id < last; ++id)
+                        for (size_t slot = 0; slot < slots_per_block; ++slot)
+                            if (keep(blocks[id].counts[slot]))
+                                thread_hashes[thread].push_back(unmix_hash(blocks[id].keys[slot]));
+                });
+            }
+        }
+
+        std::vector<uint64_t> hashes{};
+        if (keep(zero_count))
+            hashes.push_back(unmix_hash(0));
+        for (auto const & part : thread_hashes)
+            hashes.insert(hashes.end(), part.begin(), part.end());
+
+        return hashes;
+    }
+
+    //!\brief The number of bytes of the table and the prefilter.
+    size_t size_in_bytes() const noexcept
+    {
+        return (block_count + line_count) * sizeof(block);
+    }
+
+private:
+    //!\brief The number of slots per cache line.
+    static constexpr size_t slots_per_block{7};
+
+    //!\brief One cache line of the table: seven mixed hashes (0 is empty) and their counts.
+    struct alignas(64) block
+    {
+        //!\brief The mixed hashes.
+        uint64_t keys[slots_per_block]{};
+        //!\brief The counts, or the prefilter counters if the block is a prefilter line.
+        uint8_t counts[64 - slots_per_block * sizeof(uint64_t)]{};
+    };
+
+    //!\brief The number of table blocks.
+    size_t block_count{};
+    //!\brief The table.
+    std::unique_ptr<block[]> blocks{};
+    //!\brief The number of prefilter cache lines, 0 if there is no prefilter.
+    size_t line_count{};
+    //!\brief The prefilter; every line is used as 64 one-byte counters.
+    std::unique_ptr<block[]> prefilter{};
+    //!\brief The number of occurrences after which a hash enters the table.
+    size_t prefilter_threshold{};
+    //!\brief The count of the hash whose mixed value is 0.
+    uint8_t zero_count{0};
+
+    //!\brief The first block to probe for a mixed hash.
+    size_t home_block(uint64_t const key) const noexcept
+    {
+        return static_cast<size_t>((static_cast<unsigned __int128>(key) * block_count) >> 64);
+    }
+
+    //!\brief The block probed after `id`.
+    size_t next_block(size_t const id) const noexcept
+    {
+        return id + 1 == block_count ? 0 : id + 1;
+    }
+
+    //!\brief Adds `amount` to a counter, saturating at seqan3::hash_counter::max_count.
+    static void saturating_add(uint8_t & counter, uint8_t const amount) noexcept
+    {
+        saturating_add(counter, amount, amount);
+    }
+
+    /*!\brief Adds `first_amount` to a counter that is 0 and `amount` otherwise, saturating at
+     *        seqan3::hash_counter::max_count; whether the counter is 0 is decided by the same compare-and-swap.
+     */
+    static void saturating_add(uint8_t & counter, uint8_t const amount, uint8_t const first_amount) noexcept
+    {
+        std::atomic_ref<uint8_t> count{counter};
+        uint8_t current = count.load(std::memory_order_relaxed);
+        uint8_t updated{};
+
+        do
+        {
+            updated = static_cast<uint8_t>(std::min<size_t>(current + (current == 0 ? first_amount : amount),
+                                                            max_count));
+        }
+        while (current != max_count && !count.compare_exchange_weak(current, updated, std::memory_order_relaxed));
+    }
+
+    /*!\brief Increments the four prefilter counters of a mixed hash and returns the smallest of them.
+     * \details All four counters are in the same cache line, selected by the prefix of a second mix of the hash; the
+     *          positions within the line are taken from its lowest 24 bits.
+     */
+    uint8_t prefilter_insert(uint64_t const key) noexcept
+    {
+        uint64_t const line_hash = mix_hash(key ^ 0x9E3779B97F4A7C15ULL);
+        auto * const line = reinterpret_cast<uint8_t *>(
+                                &prefilter[static_cast<size_t>((static_cast<unsigned __int128>(line_hash) * line_count)
+                                                               >> 64)]);
+        uint8_t estimate{max_count};
+
+        for (size_t row = 0; row < 4; ++row)
+        {
+            uint8_t & counter = line[(line_hash >> (6 * row)) & 63];
+            saturating_add(counter, 1);
+            estimate = std::min(estimate, std::atomic_ref<uint8_t>{counter}.load(std::memory_order_relaxed));
+        }
+
+        return estimate;
+    }
+};
+} // namespace seqan3
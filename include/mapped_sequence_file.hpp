@@ -0,0 +1,434 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Hossein Eizadi Moghadam <hosseinem AT fu-berlin.de>
+ * \brief Provides seqan3::mapped_sequence_file, seqan3::mapped_record and seqan3::mapped_sequence_view.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <ranges>
+#include <string_view>
+
+#include <seqan3/alphabet/concept.hpp>
+#include <seqan3/alphabet/nucleotide/dna4.hpp>
+#include <seqan3/io/exception.hpp>
+#include "memory_mapping.hpp"
+
+namespace seqan3
+{
+namespace detail
+{
+//!\brief The letter of every character, converted like seqan3::assign_char_to.
+template <semialphabet alphabet_t>
+inline constexpr std::array<alphabet_t, 256> char_to_letter = [] ()
+{
+    std::array<alphabet_t, 256> letters{};
+    for (size_t c = 0; c < 256; ++c)
+        seqan3::assign_char_to(static_cast<char>(c), letters[c]);
+    return letters;
+}();
+
+//!\brief Whether a character ends a line.
+constexpr bool is_line_break(char const c) noexcept
+{
+    return c == '\n' || c == '\r';
+}
+} // namespace detail
+
+/*!\brief A view of the letters of a sequence in a memory-mapped file.
+ * \tparam alphabet_t The alphabet the characters are converted to, e.g. seqan3::dna4.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * The view points into the characters of the file. Line breaks are skipped and every character is converted to a
+ * letter when it is read, so nothing is copied or allocated and the view can be passed to seqan3::views::kmer_hash,
+ * syncmer_hash and the other hash views; its iterators are bidirectional, so
+ * `seqan3::views::complement | std::views::reverse` gives the reverse strand. The view is not sized, because the
+ * number of letters is only known after skipping the line breaks; use std::ranges::distance if it is needed.
+ */
+template <semialphabet alphabet_t>
+class mapped_sequence_view : public std::ranges::view_interface<mapped_sequence_view<alphabet_t>>
+{
+public:
+    //!\brief The iterator of the view.
+    class iterator
+    {
+    public:
+        using value_type = alphabet_t; //!< The letter type.
+        using reference = alphabet_t; //!< Letters are converted when they are read.
+        using difference_type = std::ptrdiff_t; //!< The difference type.
+        using iterator_category = std::bidirectional_iterator_tag; //!< The iterator category.
+        using iterator_concept = std::bidirectional_iterator_tag; //!< The iterator concept.
+
+        iterator() = default; //!< Defaulted.
+
+        //!\brief Construct from the current character and the end of the sequence characters.
+        iterator(char const * current, char const * last) noexcept : current{current}, last{last}
+        {}
+
+        //!\brief The current letter.
+        alphabet_t operator*() const noexcept
+        {
+            return detail::char_to_letter<alphabet_t>[static_cast<unsigned char>(*current)];
+        }
+
+        //!\brief Moves to the next letter, skipping line breaks.
+        iterator & operator++() noexcept
+        {
+            ++current;
+            while (current != last && detail::is_line_break(*current))
+                ++current;
+            return *this;
+        }
+
+        //!\brief Moves to the next letter and returns the previous position.
+        iterator operator++(int) noexcept
+        {
+            iterator previous{*this};
+            ++(*this);
+            return previous;
+        }
+
+        //!\brief Moves to the previous letter, skipping line breaks.
+        iterator & operator--() noexcept
+        {
+            --current;
+            while (detail::is_line_break(*current))
+                --current;
+            return *this;
+        }
+
+        //!\brief Moves to the previous letter and returns the previous position.
+        iterator operator--(int) noexcept
+        {
+            iterator previous{*this};
+            --(*this);
+            return previous;
+        }
+
+        //!\brief Compares the positions.
+        friend bool operator==(iterator const & lhs, iterator const & rhs) noexcept
+        {
+            return lhs.current == rhs.current;
+        }
+
+    private:
+        //!\brief The current character.
+        char const * current{nullptr};
+        //!\brief The end of the sequence characters.
+        char const * last{nullptr};
+    };
+
+    mapped_sequence_view() = default; //!< Defaulted.
+
+    /*!\brief Construct from the characters of a sequence.
+     * \details The characters must neither start nor end with a line break, mapped_sequence_file trims them.
+     */
+    explicit mapped_sequence_view(std::string_view const characters) noexcept : characters{characters}
+    {}
+
+    //!\brief The first letter.
+    iterator begin() const noexcept
+    {
+        return {characters.data(), characters.data() + characters.size()};
+    }
+
+    //!\brief Behind the last letter.
+    iterator end() const noexcept
+    {
+        return {characters.data() + characters.size(), characters.data() + characters.size()};
+    }
+
+private:
+    //!\brief The characters of the sequence, including line breaks.
+    std::string_view characters{};
+};
+
+/*!\brief A record of a seqan3::mapped_sequence_file.
+ * \tparam alphabet_t The alphabet of the sequence.
+ * \ingroup search_views
+ *
+ * \details All members point into the mapped file and are valid as long as the file is.
+ */
+template <semialphabet alphabet_t>
+struct mapped_record
+{
+    //!\brief The header line without '>' or '@'.
+    std::string_view id{};
+    //!\brief The characters of the sequence, including the line breaks of multi-line records.
+    std::string_view raw_sequence{};
+    //!\brief The characters of the qualities, including line breaks; empty for FASTA.
+    std::string_view raw_quality{};
+
+    //!\brief The letters of the sequence.
+    mapped_sequence_view<alphabet_t> sequence() const noexcept
+    {
+        return mapped_sequence_view<alphabet_t>{raw_sequence};
+    }
+};
+
+/*!\brief Reads the records of a FASTA or FASTQ file through a read-only memory mapping.
+ * \tparam alphabet_t The alphabet of the sequences. Default: seqan3::dna4.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * The file is mapped once and its records are parsed while iterating; a record only holds pointers into the mapping,
+ * see seqan3::mapped_record, so neither reading the file nor iterating its records copies or allocates. The pages are
+ * loaded by the kernel when they are first read and can be shared by several processes, which makes this reader
+ * suited for large references that are only sampled, e.g. by syncmer_hash:
+ *
+ * ```cpp
+ * seqan3::mapped_sequence_file file{"genome.fa"};
+ * for (auto const & record : file)
+ *     for (uint64_t hash : record.sequence() | syncmer_hash(5, 15))
+ *         ...
+ * ```
+ *
+ * The format is detected from the first character. FASTA sequences and FASTQ sequences and qualities may span several
+ * lines; empty lines between records are skipped. The file can be iterated any number of times and from several
+ * threads at once.
+ */
+template <semialphabet alphabet_t = dna4>
+class mapped_sequence_file
+{
+public:
+    //!\brief The record type.
+    using record_type = mapped_record<alphabet_t>;
+
+    //!\brief The iterator over the records; parses one record per increment.
+    class iterator
+    {
+    public:
+        using value_type = record_type; //!< The record type.
+        using reference = record_type const &; //!< The record is stored in the iterator.
+        using difference_type = std::ptrdiff_t; //!< The difference type.
+        using iterator_category = std::forward_iterator_tag; //!< The iterator category.
+        using iterator_concept = std::forward_iterator_tag; //!< The iterator concept.
+
+        iterator() = default; //!< Defaulted.
+
+        /*!\brief Construct at the first record of the characters of a file.
+         * \throws seqan3::format_error if the characters are not FASTA or FASTQ.
+         */
+        iterator(char const * first, char const * last) : next{first}, last{last}
+        {
+            ++(*this);
+        }
+
+        //!\brief The current record.
+        record_type const & operator*() const noexcept
+        {
+            return record;
+        }
+
+        //!\brief A pointer to the current record.
+        record_type const * operator->() const noexcept
+        {
+            return &record;
+        }
+
+        /*!\brief Parses the next record.
+         * \throws seqan3::format_error if the record is not a valid FASTA or FASTQ record.
+         */
+        iterator & operator++()
+        {
+            skip_line_breaks();
+            current = next;
+            if (next == last)
+                return *this;
+
+            if (*next == '>')
+                parse_fasta();
+            else if (*next == '@')
+                parse_fastq();
+            else
+                throw format_error{"Expected '>' or '@' at the start of a record, the file is neither FASTA nor FASTQ."};
+
+            return *this;
+        }
+
+        //!\brief Parses the next record and returns the previous position.
+        iterator operator++(int)
+        {
+            iterator previous{*this};
+            ++(*this);
+            return previous;
+        }
+
+        //!\brief Compares the positions.
+        friend bool operator==(iterator const & lhs, iterator const & rhs) noexcept
+        {
+            return lhs.current == rhs.current;
+        }
+
+        //!\brief Whether all records have been read.
+        friend bool operator==(iterator const & it, std::default_sentinel_t) noexcept
+        {
+            return it.current == it.last;
+        }
+
+    private:
+        //!\brief The current record.
+        record_type record{};
+        //!\brief The first character of the current record, `last` at the end.
+        char const * current{nullptr};
+        //!\brief The first character after the current record.
+        char const * next{nullptr};
+        //!\brief The end of the file.
+        char const * last{nullptr};
+
+        //!\brief The end of the line starting at `position`, i.e. its '\n' or `last`.
+        char const * line_end(char const * position) const noexcept
+        {
+            auto const * const found = static_cast<char const *>(std::memchr(position, '\n', last - position));
+            return found == nullptr ? last : found;
+        }
+
+        //!\brief The character after the end of the line starting at `position`.
+        char const * next_line(char const * position) const noexcept
+        {
+            char const * const end = line_end(position);
+            return end == last ? last : end + 1;
+        }
+
+        //!\brief Removes the line breaks at the end of `[first, end)`.
+        static std::string_view trimmed(char const * first, char const * end) noexcept
+        {
+            while (end != first && detail::is_line_break(end[-1]))
+                --end;
+            return {first, static_cast<size_t>(end - first)};
+        }
+
+        //!\brief Skips empty lines before a record.
+        void skip_line_breaks() noexcept
+        {
+            while (next != last && detail::is_line_break(*next))
+                ++next;
+        }
+
+        //!\brief Parses the FASTA record at `next`; its sequence ends before the next '>' at the start of a line.
+        void parse_fasta() noexcept
+        {
+            char const * const sequence_start = next_line(next);
+            record.id = trimmed(next + 1, sequence_start);
+            record.raw_quality = {};
+
+            char const * end = sequence_start;
+            while (end != last)
+            {
+                end = static_cast<char const *>(std::memchr(end, '>', last - end));
+                if (end == nullptr)
+                    end = last;
+                else if (end[-1] == '\n')
+                    break;
+                else
+                    ++end;
+            }
+
+            // Skip the leading line breaks of the sequence, the view must start with a letter.
+            char const * first = sequence_start;
+            while (first != end && detail::is_line_break(*first))
+                ++first;
+
+            record.raw_sequence = trimmed(first, end);
+            next = end;
+        }
+
+        /*!\brief Parses the FASTQ record at `next`; the sequence ends at the first line starting with '+', the qualities
+         *        after as many characters as the sequence has letters.
+         * \throws seqan3::format_error if there is no '+' line or there are fewer qualities than letters.
+         */
+        void parse_fastq()
+        {
+            char const * const sequence_start = next_line(next);
+            record.id = trimmed(next + 1, sequence_start);
+
+            size_t length{0};
+            char const * line = sequence_start;
+            while (line != last && *line != '+')
+            {
+                char const * const end = line_end(line);
+                length += trimmed(line, end).size();
+                line = end == last ? last : end + 1;
+            }
+
+            if (line == last)
+                throw format_error{"The FASTQ record " + std::string{record.id} + " has no '+' line."};
+
+            record.raw_sequence = trimmed(sequence_start, line);
+
+            char const * const quality_start = next_line(line);
+            char const * quality_end = quality_start;
+            for (size_t qualities = 0; qualities < length; ++quality_end)
+            {
+                if (quality_end == last)
+                    throw format_error{"The FASTQ record " + std::string{record.id} + " has fewer qualities than "
+                                       "letters."};
+                qualities += !detail::is_line_break(*quality_end);
+            }
+
+            record.raw_quality = {quality_start, static_cast<size_t>(quality_end - quality_start)};
+            next = next_line(quality_end);
+        }
+    };
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    mapped_sequence_file() = delete; //!< Deleted.
+    mapped_sequence_file(mapped_sequence_file const &) = delete; //!< Deleted.
+    mapped_sequence_file(mapped_sequence_file &&) = default; //!< Defaulted.
+    mapped_sequence_file & operator=(mapped_sequence_file const &) = delete; //!< Deleted.
+    mapped_sequence_file & operator=(mapped_sequence_file &&) = default; //!< Defaulted.
+    ~mapped_sequence_file() = default; //!< Defaulted.
+
+    /*!\brief Maps a file.
+     * \param[in] path The FASTA or FASTQ file.
+     * \throws seqan3::file_open_error if the file cannot be opened or mapped.
+     */
+    explicit mapped_sequence_file(std::filesystem::path const & path) : mapping{path, MADV_SEQUENTIAL}
+    {}
+    //!\}
+
+    /*!\brief The first record.
+     * \throws seqan3::format_error if the file is not FASTA or FASTQ.
+     */
+    iterator begin() const
+    {
+        return {mapping.data().data(), mapping.data().data() + mapping.data().size()};
+    }
+
+    //!\brief Behind the last record.
+    std::default_sentinel_t end() const noexcept
+    {
+        return {};
+    }
+
+    //!\brief All characters of the file.
+    std::string_view data() const noexcept
+    {
+        return mapping.data();
+    }
+
+private:
+    //!\brief The mapped file.
+    detail::memory_mapping mapping{};
+};
+} // namespace seqan3
+
+//!\cond
+template <typename alphabet_t>
+inline constexpr bool std::ranges::enable_borrowed_range<seqan3::mapped_sequence_view<alphabet_t>> = true;
+//!\endcond
@@ -0,0 +1,104 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Hossein Eizadi Moghadam <hosseinem AT fu-berlin.de>
+ * \brief Provides seqan3::detail::memory_mapping.
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <seqan3/io/exception.hpp>
+
+namespace seqan3::detail
+{
+/*!\brief A read-only memory mapping of a whole file.
+ * \details The mapping is private and unmapped on destruction; an empty file has an empty mapping.
+ */
+class memory_mapping
+{
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    memory_mapping() = default; //!< Defaulted.
+    memory_mapping(memory_mapping const &) = delete; //!< Deleted.
+    memory_mapping & operator=(memory_mapping const &) = delete; //!< Deleted.
+
+    //!\brief Takes over the mapping.
+    memory_mapping(memory_mapping && other) noexcept : bytes{std::exchange(other.bytes, {})}
+    {}
+
+    //!\brief Takes over the mapping.
+    memory_mapping & operator=(memory_mapping && other) noexcept
+    {
+        std::swap(bytes, other.bytes);
+        return *this;
+    }
+
+    //!\brief Unmaps the file.
+    ~memory_mapping()
+    {
+        if (!bytes.empty())
+            munmap(const_cast<char *>(bytes.data()), bytes.size());
+    }
+
+    /*!\brief Maps a file.
+     * \param[in] path   The file.
+     * \param[in] advice The expected access pattern passed to madvise, e.g. MADV_SEQUENTIAL or MADV_RANDOM.
+     * \throws seqan3::file_open_error if the file cannot be opened or mapped.
+     */
+    memory_mapping(std::filesystem::path const & path, int const advice)
+    {
+        int const descriptor = open(path.c_str(), O_RDONLY);
+        if (descriptor == -1)
+            throw file_open_error{"Could not open the file " + path.string() + "."};
+
+        struct stat status{};
+        if (fstat(descriptor, &status) == -1)
+        {
+            close(descriptor);
+            throw file_open_error{"Could not determine the size of the file " + path.string() + "."};
+        }
+
+        size_t const size = static_cast<size_t>(status.st_size);
+        if (size != 0)
+        {
+            void * const mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (mapping == MAP_FAILED)
+            {
+                close(descriptor);
+                throw file_open_error{"Could not map the file " + path.string() + "."};
+            }
+            madvise(mapping, size, advice);
+            bytes = {static_cast<char const *>(mapping), size};
+        }
+
+        close(descriptor);
+    }
+    //!\}
+
+    //!\brief The bytes of the file.
+    std::string_view data() const noexcept
+    {
+        return bytes;
+    }
+
+private:
+    //!\brief The mapped bytes, empty for an empty file.
+    std::string_view bytes{};
+};
+} // namespace seqan3::detail
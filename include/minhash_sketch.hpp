@@ -0,0 +1,267 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Hossein Eizadi Moghadam <hosseinem AT fu-berlin.de>
+ * \brief Provides seqan3::bottom_sketch and seqan3::scaled_sketch.
+ */
+
+#pragma once
+
+#include <seqan3/std/algorithm>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "shared.hpp"
+
+namespace seqan3
+{
+/*!\brief A bottom-s MinHash sketch: the `sketch_size` smallest distinct mixed hashes of a stream, e.g. of syncmer_hash
+ *        or seqan3::views::kmer_hash.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * The hashes are spread with mix_hash, so the sketch is a uniform sample of the distinct hashes whatever order the
+ * sampling scheme produces; the sketch stores the mixed values, which are a bijection of the hashes.
+ *
+ * The sketch is a streaming partial sort with at most `2 * sketch_size` values in memory: a mixed hash is appended to
+ * a buffer if it is smaller than the largest kept value, and when the buffer is full it is sorted, deduplicated and
+ * cut to `sketch_size` values. A bounded max-heap would need a lookup per hash to reject duplicates; here the common
+ * case, a hash larger than the largest kept value, is a single comparison, and a full buffer costs
+ * O(s log s) for at least s accepted hashes.
+ *
+ * Sketches of chunks of the same stream, e.g. of different sequences of a genome computed by several threads, are
+ * combined with merge(); the result equals the sketch of the whole stream.
+ */
+class bottom_sketch
+{
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    bottom_sketch() = default; //!< Defaulted.
+    bottom_sketch(bottom_sketch const &) = default; //!< Defaulted.
+    bottom_sketch(bottom_sketch &&) = default; //!< Defaulted.
+    bottom_sketch & operator=(bottom_sketch const &) = default; //!< Defaulted.
+    bottom_sketch & operator=(bottom_sketch &&) = default; //!< Defaulted.
+    ~bottom_sketch() = default; //!< Defaulted.
+
+    /*!\brief Construct an empty sketch.
+     * \param[in] sketch_size The number of hashes kept.
+     * \throws std::invalid_argument if `sketch_size` is 0.
+     */
+    explicit bottom_sketch(size_t const sketch_size) : sketch_size{sketch_size}
+    {
+        if (sketch_size == 0)
+            throw std::invalid_argument{"The chosen sketch_size is not valid. Please choose a value greater than 0."};
+
+        buffer.reserve(2 * sketch_size);
+    }
+    //!\}
+
+    //!\brief Adds a hash.
+    void insert(uint64_t const hash)
+    {
+        insert_mixed(mix_hash(hash));
+    }
+
+    //!\brief Adds every hash of a range, e.g. `sequence | syncmer_hash(s, k)`.
+    template <std::ranges::input_range hashes_t>
+    void insert(hashes_t && hashes)
+    {
+        for (uint64_t const hash : hashes)
+            insert_mixed(mix_hash(hash));
+    }
+
+    /*!\brief Adds the hashes of a sketch with the same sketch size; merging a sketch with itself changes nothing.
+     * \throws std::invalid_argument if the sketch sizes differ.
+     */
+    void merge(bottom_sketch const & other)
+    {
+        if (sketch_size != other.sketch_size)
+            throw std::invalid_argument{"The chosen sketches are not valid. "
+                                        "Please merge sketches with the same sketch_size."};
+
+        if (&other == this)
+            return;
+
+        for (uint64_t const mixed : other.buffer)
+            insert_mixed(mixed);
+    }
+
+    /*!\brief The kept mixed hashes in increasing order, at most `sketch_size`.
+     * \details Compacts the buffer; the span is valid until the next insertion.
+     */
+    std::span<uint64_t const> hashes()
+    {
+        compact();
+        return buffer;
+    }
+
+    //!\brief The number of hashes kept.
+    size_t capacity() const noexcept
+    {
+        return sketch_size;
+    }
+
+private:
+    //!\brief The number of hashes kept.
+    size_t sketch_size{1};
+    //!\brief Mixed hashes at least this large are not kept; the largest kept value once `sketch_size` are kept.
+    uint64_t threshold{std::numeric_limits<uint64_t>::max()};
+    //!\brief The number of kept values at the front of the buffer.
+    size_t kept{};
+    //!\brief The kept values followed by the candidates added since the last compaction.
+    std::vector<uint64_t> buffer{};
+
+    //!\brief Adds a mixed hash.
+    void insert_mixed(uint64_t const mixed)
+    {
+        if (mixed >= threshold)
+            return;
+
+        buffer.push_back(mixed);
+        if (buffer.size() >= 2 * sketch_size)
+            compact();
+    }
+
+    //!\brief Keeps the `sketch_size` smallest distinct values in increasing order.
+    void compact()
+    {
+        // The kept values are sorted already, only the candidates are sorted and merged into them.
+        std::sort(buffer.begin() + kept, buffer.end());
+        std::inplace_merge(buffer.begin(), buffer.begin() + kept, buffer.end());
+        buffer.erase(std::unique(buffer.begin(), buffer.end()), buffer.end());
+
+        if (buffer.size() >= sketch_size)
+        {
+            buffer.resize(sketch_size);
+            threshold = buffer.back();
+        }
+        kept = buffer.size();
+    }
+};
+
+/*!\brief A scaled MinHash (FracMinHash) sketch: all distinct mixed hashes of a stream up to `2^64 / scale`.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * A hash is kept under the same condition as in seqan3::scaled_sampler, so the sketch holds the mixed values of the
+ * hashes that scaled_syncmer_hash would produce. Unlike seqan3::bottom_sketch the size grows with the number of
+ * distinct hashes, one in `scale`, and sketches of different sequences estimate containment directly.
+ *
+ * The sampled values are appended to a buffer that is sorted and deduplicated whenever it has doubled since the last
+ * compaction, so repeated hashes take amortised constant memory. Sketches of chunks are combined with merge().
+ */
+class scaled_sketch
+{
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    scaled_sketch() = default; //!< Defaulted.
+    scaled_sketch(scaled_sketch const &) = default; //!< Defaulted.
+    scaled_sketch(scaled_sketch &&) = default; //!< Defaulted.
+    scaled_sketch & operator=(scaled_sketch const &) = default; //!< Defaulted.
+    scaled_sketch & operator=(scaled_sketch &&) = default; //!< Defaulted.
+    ~scaled_sketch() = default; //!< Defaulted.
+
+    /*!\brief Construct an empty sketch.
+     * \param[in] scale The scale factor, a value of 1 keeps all hashes.
+     * \throws std::invalid_argument if `scale` is 0.
+     */
+    explicit scaled_sketch(uint64_t const scale) : scale_{scale}
+    {
+        if (scale == 0)
+            throw std::invalid_argument{"The chosen scale is not valid. Please choose a value greater than 0."};
+
+        max_hash = std::numeric_limits<uint64_t>::max() / scale;
+    }
+    //!\}
+
+    //!\brief Adds a hash.
+    void insert(uint64_t const hash)
+    {
+        insert_mixed(mix_hash(hash));
+    }
+
+    //!\brief Adds every hash of a range, e.g. `sequence | syncmer_hash(s, k)`.
+    template <std::ranges::input_range hashes_t>
+    void insert(hashes_t && hashes)
+    {
+        for (uint64_t const hash : hashes)
+            insert_mixed(mix_hash(hash));
+    }
+
+    /*!\brief Adds the hashes of a sketch with the same scale; merging a sketch with itself changes nothing.
+     * \throws std::invalid_argument if the scales differ.
+     */
+    void merge(scaled_sketch const & other)
+    {
+        if (scale_ != other.scale_)
+            throw std::invalid_argument{"The chosen sketches are not valid. "
+                                        "Please merge sketches with the same scale."};
+
+        if (&other == this)
+            return;
+
+        for (uint64_t const mixed : other.buffer)
+            insert_mixed(mixed);
+    }
+
+    /*!\brief The kept mixed hashes in increasing order.
+     * \details Compacts the buffer; the span is valid until the next insertion.
+     */
+    std::span<uint64_t const> hashes()
+    {
+        compact();
+        return buffer;
+    }
+
+    //!\brief The scale factor.
+    uint64_t scale() const noexcept
+    {
+        return scale_;
+    }
+
+private:
+    //!\brief The scale factor.
+    uint64_t scale_{1};
+    //!\brief The largest mixed hash that is kept.
+    uint64_t max_hash{std::numeric_limits<uint64_t>::max()};
+    //!\brief The number of distinct values after the last compaction.
+    size_t compacted{};
+    //!\brief The kept values followed by the values added since the last compaction.
+    std::vector<uint64_t> buffer{};
+
+    //!\brief Adds a mixed hash.
+    void insert_mixed(uint64_t const mixed)
+    {
+        if (mixed > max_hash)
+            return;
+
+        buffer.push_back(mixed);
+        if (buffer.size() >= 2 * compacted + 1024)
+            compact();
+    }
+
+    //!\brief Sorts and deduplicates the values.
+    void compact()
+    {
+        std::sort(buffer.begin() + compacted, buffer.end());
+        std::inplace_merge(buffer.begin(), buffer.begin() + compacted, buffer.end());
+        buffer.erase(std::unique(buffer.begin(), buffer.end()), buffer.end());
+        compacted = buffer.size();
+    }
+};
+} // namespace seqan3
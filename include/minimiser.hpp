@@ -13,7 +13,6 @@
 #pragma once
 
 #include <seqan3/std/algorithm>
-#include <deque>
 
 #include <seqan3/core/detail/empty_type.hpp>
 #include <seqan3/core/range/detail/adaptor_from_functor.hpp>
@@ -21,6 +20,9 @@
 #include <seqan3/utility/range/concept.hpp>
 #include <seqan3/utility/type_traits/lazy_conditional.hpp>
 
+#include "sampling_stats.hpp"
+#include "window_buffer.hpp"
+
 namespace seqan3::detail
 {
 // ---------------------------------------------------------------------------------------------------------------------
@@ -137,7 +139,7 @@ public:
     {
         if constexpr (second_range_is_given)
         {
-            if (std::ranges::distance(urange1) != std::ranges::distance(urange2))
+            if (std::ranges::distance(this->urange1) != std::ranges::distance(this->urange2))
                 throw std::invalid_argument{"The two ranges do not have the same size."};
         }
     }
@@ -167,7 +169,7 @@ public:
     {
         if constexpr (second_range_is_given)
         {
-            if (std::ranges::distance(urange1) != std::ranges::distance(urange2))
+            if (std::ranges::distance(this->urange1) != std::ranges::distance(this->urange2))
                 throw std::invalid_argument{"The two ranges do not have the same size."};
         }
     }
@@ -229,6 +231,16 @@ public:
         return {};
     }
     //!\}
+
+    /*!\brief Traverses the view and returns the counters of its iterator, see seqan3::sampling_stats.
+     * \details All counters are 0 unless SEQAN3_SAMPLING_STATS is 1.
+     */
+    sampling_stats stats()
+    {
+        auto it = begin();
+        for (; it != end(); ++it) {}
+        return it.stats();
+    }
 };
 
 //!\brief Iterator for calculating minimisers.
@@ -284,7 +296,9 @@ public:
           urng1_iterator{std::move(it.urng1_iterator)},
           urng1_sentinel{std::move(it.urng1_sentinel)},
           urng2_iterator{std::move(it.urng2_iterator)},
-          window_values{std::move(it.window_values)}
+          window_values{std::move(it.window_values)},
+          window_position{it.window_position},
+          counters{it.counters}
     {}
 
     /*!\brief Construct from begin and end iterators of a given range over std::totally_ordered values, and the number
@@ -379,6 +393,67 @@ public:
         return minimiser_value;
     }
 
+    //!\brief The position of the current window, the index of its first value.
+    size_t position() const noexcept
+    {
+        return window_position;
+    }
+
+    //!\brief The work of the traversal so far; all counters are 0 unless SEQAN3_SAMPLING_STATS is 1.
+    sampling_stats stats() const noexcept
+    {
+        return counters.stats();
+    }
+
+    /*!\brief Moves to the window starting at `position`.
+     * \param[in] position The index of the first value of a window; positions behind the last window move the
+     *                     iterator to the end.
+     * \details
+     *
+     * Only the window at `position` is read, so a region of a long sequence or a chunk processed by one thread starts
+     * in O(window size) steps instead of scanning from the beginning. The iterator then points to the minimiser of
+     * that window, which a traversal from the beginning may have returned for an earlier window already.
+     *
+     * Every window has the same minimiser as in a traversal from the beginning. Which of several equal smallest values
+     * is tracked depends on all previous windows, though, so when a value occurs more than once in a window, the two
+     * traversals may return the same minimiser a different number of times in a row.
+     */
+    basic_iterator & seek(size_t const position)
+    //!\cond
+        requires std::random_access_iterator<urng1_iterator_t> &&
+                 std::sized_sentinel_for<urng1_sentinel_t, urng1_iterator_t> &&
+                 (!second_range_is_given || std::random_access_iterator<urng2_iterator_t>)
+    //!\endcond
+    {
+        difference_type const skip = static_cast<difference_type>(position) -
+                                     static_cast<difference_type>(window_position);
+        difference_type const remaining = urng1_sentinel - urng1_iterator;
+        difference_type const step = std::min(skip, remaining);
+
+        urng1_iterator += step;
+        if constexpr (second_range_is_given)
+            urng2_iterator += step;
+        window_position += step;
+
+        if (skip >= remaining)
+            return *this;
+
+        difference_type const window_size = window_values.size();
+        window_values.clear();
+        for (difference_type back = window_size - 1; back >= 0; --back)
+        {
+            if constexpr (!second_range_is_given)
+                window_values.push_back(*(urng1_iterator - back));
+            else
+                window_values.push_back(std::min(*(urng1_iterator - back), *(urng2_iterator - back)));
+        }
+
+        auto minimiser_it = std::ranges::min_element(window_values, std::less_equal<value_type>{});
+        minimiser_value = *minimiser_it;
+        minimiser_position_offset = std::distance(std::begin(window_values), minimiser_it);
+        return *this;
+    }
+
 private:
     //!\brief The minimiser value.
     value_type minimiser_value{};
@@ -394,7 +469,13 @@ private:
     urng2_iterator_t urng2_iterator{};
 
     //!\brief Stored values per window. It is necessary to store them, because a shift can remove the current minimiser.
-    std::deque<value_type> window_values{};
+    window_buffer<value_type> window_values{};
+
+    //!\brief The index of the first value of the current window.
+    size_t window_position{};
+
+    //!\brief The counters of stats().
+    [[no_unique_address]] detail::sampling_counters<> counters{};
 
     //!\brief Increments iterator by 1.
     void next_unique_minimiser()
@@ -434,6 +515,9 @@ private:
         auto minimiser_it = std::ranges::min_element(window_values, std::less_equal<value_type>{});
         minimiser_value = *minimiser_it ;
         minimiser_position_offset = std::distance(std::begin(window_values), minimiser_it);
+        counters.position();
+        counters.rescan(window_size);
+        counters.sample();
     }
 
     /*!\brief Calculates the next minimiser value.
@@ -445,10 +529,12 @@ private:
     bool next_minimiser()
     {
         advance_window();
+        ++window_position;
         if (urng1_iterator == urng1_sentinel)
             return true;
 
         value_type const new_value = window_value();
+        counters.position();
 
         window_values.pop_front();
         window_values.push_back(new_value);
@@ -458,6 +544,8 @@ private:
             auto minimiser_it = std::ranges::min_element(window_values, std::less_equal<value_type>{});
             minimiser_value = *minimiser_it ;
             minimiser_position_offset = std::distance(std::begin(window_values), minimiser_it);
+            counters.rescan(window_values.size());
+            counters.sample();
             return true;
         }
 
@@ -465,9 +553,11 @@ private:
         {
             minimiser_value = new_value;
             minimiser_position_offset = window_values.size() - 1;
+            counters.sample();
             return true;
         }
 
+        counters.tie(new_value == minimiser_value);
         --minimiser_position_offset;
         return false;
     }
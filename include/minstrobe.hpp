@@ -13,7 +13,7 @@
 #pragma once
 
 #include <seqan3/std/algorithm>
-#include <deque>
+#include <array>
 
 #include <seqan3/core/detail/empty_type.hpp>
 #include <seqan3/core/range/detail/adaptor_from_functor.hpp>
@@ -21,6 +21,9 @@
 #include <seqan3/utility/range/concept.hpp>
 #include <seqan3/utility/type_traits/lazy_conditional.hpp>
 
+#include "sampling_stats.hpp"
+#include "window_buffer.hpp"
+
 namespace seqan3::detail
 {
 // ---------------------------------------------------------------------------------------------------------------------
@@ -164,6 +167,16 @@ public:
         return {};
     }
     //!\}
+
+    /*!\brief Traverses the view and returns the counters of its iterator, see seqan3::sampling_stats.
+     * \details All counters are 0 unless SEQAN3_SAMPLING_STATS is 1.
+     */
+    sampling_stats stats()
+    {
+        auto it = begin();
+        for (; it != end(); ++it) {}
+        return it.stats();
+    }
 };
 
 //!\brief Iterator for calculating minstrobes.
@@ -189,7 +202,7 @@ public:
     //!\brief Value type of the iterator.
     using value_t = std::ranges::range_value_t<urng_t>;
     //!\brief Value type of the output.
-    using value_type = std::vector<value_t>;
+    using value_type = std::array<value_t, 2>;
     //!\brief The pointer type.
     using pointer = void;
     //!\brief Reference to `value_type`.
@@ -230,8 +243,8 @@ public:
     *
     * \details
     *
-    * Looks at the number of values per two windows with three iterators. First iterator adds the next value in the vector as
-    * the first strobe. The second iterator adds the minimum value of the second window to the second position of the vector.
+    * Looks at the number of values per two windows with three iterators. First iterator adds the next value in the array as
+    * the first strobe. The second iterator adds the minimum value of the second window to the second position of the array.
     *
     */
     basic_iterator(urng_iterator_t second_iterator,
@@ -312,6 +325,52 @@ public:
         return minstrobe_value;
     }
 
+    //!\brief The position of the current minstrobe, the index of its first strobe.
+    size_t position() const noexcept
+    {
+        return window_position;
+    }
+
+    //!\brief The work of the traversal so far; all counters are 0 unless SEQAN3_SAMPLING_STATS is 1.
+    sampling_stats stats() const noexcept
+    {
+        return counters.stats();
+    }
+
+    /*!\brief Moves to the minstrobe whose first strobe is at `position`.
+     * \param[in] position The index of a first strobe; positions behind the last minstrobe move the iterator to the
+     *                     end.
+     * \details Only the second window of the minstrobe at `position` is read, so a region of a long sequence or a
+     *          chunk processed by one thread starts in O(window size) steps instead of scanning from the beginning.
+     */
+    basic_iterator & seek(size_t const position)
+    //!\cond
+        requires std::random_access_iterator<urng_iterator_t> &&
+                 std::sized_sentinel_for<urng_sentinel_t, urng_iterator_t>
+    //!\endcond
+    {
+        difference_type const skip = static_cast<difference_type>(position) -
+                                     static_cast<difference_type>(window_position);
+        difference_type const remaining = urng_sentinel - second_iterator;
+        difference_type const step = std::min(skip, remaining);
+
+        first_iterator += step;
+        second_iterator += step;
+        window_position += step;
+
+        if (skip >= remaining)
+            return *this;
+
+        window_values.clear();
+        for (difference_type back = window_size - 1; back >= 0; --back)
+            window_values.push_back(*(second_iterator - back));
+
+        auto minstrobe_it = std::ranges::min_element(window_values, std::less_equal<value_t>{});
+        minstrobe_value = {*first_iterator, *minstrobe_it};
+        minstrobe_position_offset = std::distance(std::begin(window_values), minstrobe_it);
+        return *this;
+    }
+
 private:
     //!\brief The minstrobe value.
     value_type minstrobe_value{};
@@ -329,16 +388,23 @@ private:
     urng_sentinel_t urng_sentinel{};
 
     //!\brief Stored values per window. It is necessary to store them, because a shift can remove the current minstrobe.
-    std::deque<value_t> window_values{};
+    window_buffer<value_t> window_values{};
 
     //!\brief The number of values in one window.
     size_t window_size{};
 
+    //!\brief The index of the first strobe.
+    size_t window_position{};
+
+    //!\brief The counters of stats().
+    [[no_unique_address]] detail::sampling_counters<> counters{};
+
     //!\brief Advances the window of the first iterator to the next position.
     void advance_windows()
     {
         ++first_iterator;
         ++second_iterator;
+        ++window_position;
     }
 
     //!\brief Calculates minstrobes for the first window.
@@ -362,6 +428,9 @@ private:
         auto minstrobe_it = std::ranges::min_element(window_values, std::less_equal<value_t>{});
         minstrobe_value = {*first_iterator, *minstrobe_it};
         minstrobe_position_offset = std::distance(std::begin(window_values), minstrobe_it);
+        counters.position();
+        counters.rescan(window_size);
+        counters.sample();
     }
 
     /*!\brief Calculates the next minstrobe value.
@@ -372,6 +441,11 @@ private:
     void next_minstrobe()
     {
         advance_windows();
+        if (second_iterator != urng_sentinel)
+        {
+            counters.position();
+            counters.sample();
+        }
 
         value_t const new_value = *first_iterator;
         value_t const sw_new_value = *second_iterator;
@@ -393,9 +467,11 @@ private:
             auto minstrobe_it = std::ranges::min_element(window_values, std::less_equal<value_t>{});
             minstrobe_value[1] = *minstrobe_it;
             minstrobe_position_offset = std::distance(std::begin(window_values), minstrobe_it);
+            counters.rescan(window_size);
             return;
         }
 
+        counters.tie(sw_new_value == minstrobe_value[1]);
         --minstrobe_position_offset;
     }
 };
@@ -430,7 +506,7 @@ struct minstrobe_fn
      *                        std::ranges::forward_range.
      * \param[in] window_min  The lower offset for the position of the next window from the previous one.
      * \param[in] window_max  The upper offset for the position of the next window from the previous one.
-     * \returns  A range of the converted values in vectors of size 2.
+     * \returns  A range of the converted values in arrays of size 2.
      */
     template <std::ranges::range urng_t>
     constexpr auto operator()(urng_t && urange, size_t const window_min, size_t const window_max) const
@@ -460,7 +536,7 @@ namespace seqan3::views
  * \param[in] urange The range being processed. [parameter is omitted in pipe notation]
  * \param[in] window_min  The lower offset for the position of the next window from the previous one.
  * \param[in] window_max  The upper offset for the position of the next window from the previous one.
- * \returns A range of std::totally_ordered where each value is a vector of size 2. See below for the
+ * \returns A range of std::totally_ordered where each value is a std::array of size 2. See below for the
  *          properties of the returned range.
  * \ingroup search_views
  *
@@ -0,0 +1,490 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Hossein Eizadi Moghadam <hosseinem AT fu-berlin.de>
+ * \brief Provides modmer and the mod and scaled (FracMinHash) samplers.
+ */
+
+#pragma once
+
+#include <seqan3/std/algorithm>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+
+#include <seqan3/core/detail/empty_type.hpp>
+#include <seqan3/core/range/detail/adaptor_from_functor.hpp>
+#include <seqan3/core/range/type_traits.hpp>
+#include <seqan3/utility/range/concept.hpp>
+#include "shared.hpp"
+
+namespace seqan3
+{
+/*!\brief Keeps a hash if its mixed value is divisible by `mod`, i.e. one in `mod` hashes is sampled.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * The hash is first spread with mix_hash, the divisibility of its lower 32 bits is tested with Lemire's
+ * multiplication trick (`n * c <= c - 1` with `c = ceil(2^64 / mod)`), which needs neither a division nor a branch
+ * and is vectorised by the compiler in seqan3::compact_sampled.
+ */
+struct mod_sampler
+{
+    //!\brief `ceil(2^64 / mod)`.
+    uint64_t divisibility_factor{1};
+
+    mod_sampler() = default; //!< Defaulted.
+
+    /*!\brief Construct from the modulus.
+     * \param[in] mod The modulus, a value of 1 keeps all hashes.
+     * \throws std::invalid_argument if `mod` is 0 or does not fit into 32 bits.
+     */
+    explicit mod_sampler(uint64_t const mod)
+    {
+        if (mod == 0 || mod > std::numeric_limits<uint32_t>::max())
+            throw std::invalid_argument{"The chosen mod is not valid. Please choose a value in [1, 2^32)."};
+
+        divisibility_factor = std::numeric_limits<uint64_t>::max() / mod + 1;
+    }
+
+    //!\brief Returns true, if the hash is sampled.
+    constexpr bool operator()(uint64_t const hash) const noexcept
+    {
+        return static_cast<uint32_t>(mix_hash(hash)) * divisibility_factor <= divisibility_factor - 1;
+    }
+};
+
+/*!\brief Keeps a hash if its mixed value is not larger than `2^64 / scale` (FracMinHash), i.e. one in `scale` hashes
+ *        is sampled.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * Unlike seqan3::mod_sampler, the sampled hashes of a scale are a subset of the sampled hashes of any smaller scale,
+ * so sketches with different scales can still be compared after downsampling to the larger one.
+ */
+struct scaled_sampler
+{
+    //!\brief The largest mixed hash that is sampled.
+    uint64_t max_hash{std::numeric_limits<uint64_t>::max()};
+
+    scaled_sampler() = default; //!< Defaulted.
+
+    /*!\brief Construct from the scale factor.
+     * \param[in] scale The scale factor, a value of 1 keeps all hashes.
+     * \throws std::invalid_argument if `scale` is 0.
+     */
+    explicit scaled_sampler(uint64_t const scale)
+    {
+        if (scale == 0)
+            throw std::invalid_argument{"The chosen scale is not valid. Please choose a value greater than 0."};
+
+        max_hash = std::numeric_limits<uint64_t>::max() / scale;
+    }
+
+    //!\brief Returns true, if the hash is sampled.
+    constexpr bool operator()(uint64_t const hash) const noexcept
+    {
+        return mix_hash(hash) <= max_hash;
+    }
+};
+
+/*!\brief Removes all hashes that are not sampled from a contiguous block of hashes.
+ * \tparam sampler_t The type of the sampler, e.g. seqan3::mod_sampler or seqan3::scaled_sampler.
+ * \param[in,out] hashes  The hashes, the sampled ones are moved to the front in their original order.
+ * \param[in]     sampler The sampler.
+ * \returns The number of sampled hashes.
+ *
+ * \details
+ *
+ * Every hash is written to the current output position and the position is advanced by the result of the sampler,
+ * so the loop has no data dependent branch. Use this instead of seqan3::views::modmer when the hashes of a whole
+ * block are already materialised.
+ */
+template <typename sampler_t>
+size_t compact_sampled(std::span<uint64_t> hashes, sampler_t const & sampler) noexcept
+{
+    size_t sampled{0};
+
+    for (uint64_t const hash : hashes)
+    {
+        hashes[sampled] = hash;
+        sampled += sampler(hash);
+    }
+
+    return sampled;
+}
+} // namespace seqan3
+
+namespace seqan3::detail
+{
+// ---------------------------------------------------------------------------------------------------------------------
+// modmer_view class
+// ---------------------------------------------------------------------------------------------------------------------
+
+/*!\brief The type returned by modmer.
+ * \tparam urng_t    The type of the underlying range, must model std::ranges::forward_range, the reference type must
+ *                   be convertible to `uint64_t`. The typical use case is that the reference type is the result of
+ *                   seqan3::kmer_hash.
+ * \tparam sampler_t The type of the sampler, seqan3::mod_sampler or seqan3::scaled_sampler.
+ * \implements std::ranges::view
+ * \ingroup search_views
+ *
+ * \note Most members of this class are generated by std::ranges::view_interface which is not yet documented here.
+ */
+template <std::ranges::view urng_t, typename sampler_t = seqan3::mod_sampler>
+class modmer_view : public std::ranges::view_interface<modmer_view<urng_t, sampler_t>>
+{
+private:
+    static_assert(std::ranges::forward_range<urng_t>, "The modmer_view only works on forward_ranges.");
+    static_assert(std::convertible_to<std::ranges::range_reference_t<urng_t>, uint64_t>,
+                  "The reference type of the underlying range must be convertible to uint64_t.");
+
+    //!\brief Whether the given range is const_iterable.
+    static constexpr bool const_iterable = seqan3::const_iterable_range<urng_t>;
+
+    //!\brief The underlying range.
+    urng_t urange{};
+
+    //!\brief The sampler deciding which values are kept.
+    sampler_t sampler{};
+
+    template <bool const_range>
+    class basic_iterator;
+
+    //!\brief The sentinel type of the modmer_view.
+    using sentinel = std::default_sentinel_t;
+
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+     /// \cond Workaround_Doxygen
+    modmer_view() requires std::default_initializable<urng_t> = default; //!< Defaulted.
+    /// \endcond
+    modmer_view(modmer_view const & rhs) = default; //!< Defaulted.
+    modmer_view(modmer_view && rhs) = default; //!< Defaulted.
+    modmer_view & operator=(modmer_view const & rhs) = default; //!< Defaulted.
+    modmer_view & operator=(modmer_view && rhs) = default; //!< Defaulted.
+    ~modmer_view() = default; //!< Defaulted.
+
+    /*!\brief Construct from a view and a sampler.
+    * \param[in] urange  The input range to process. Must model std::ranges::viewable_range and
+    *                    std::ranges::forward_range.
+    * \param[in] sampler The sampler deciding which values are kept.
+    */
+    modmer_view(urng_t urange, sampler_t const sampler) :
+        urange{std::move(urange)},
+        sampler{sampler}
+    {}
+
+    /*!\brief Construct from a non-view that can be view-wrapped and a sampler.
+    * \tparam other_urng_t  The type of another urange. Must model std::ranges::viewable_range and be
+    *                       constructible from urng_t.
+    * \param[in] urange     The input range to process. Must model std::ranges::viewable_range and
+    *                       std::ranges::forward_range.
+    * \param[in] sampler    The sampler deciding which values are kept.
+    */
+    template <typename other_urng_t>
+    //!\cond
+        requires (std::ranges::viewable_range<other_urng_t> &&
+                  std::constructible_from<urng_t, ranges::ref_view<std::remove_reference_t<other_urng_t>>>)
+    //!\endcond
+    modmer_view(other_urng_t && urange, sampler_t const sampler) :
+        urange{std::views::all(std::forward<other_urng_t>(urange))},
+        sampler{sampler}
+    {}
+    //!\}
+
+    /*!\name Iterators
+     * \{
+     */
+    /*!\brief Returns an iterator to the first element of the range.
+     * \returns Iterator to the first element.
+     *
+     * \details
+     *
+     * ### Complexity
+     *
+     * Linear in the number of values before the first sampled value.
+     *
+     * ### Exceptions
+     *
+     * Strong exception guarantee.
+     */
+    basic_iterator<false> begin()
+    {
+        return {std::ranges::begin(urange), std::ranges::end(urange), sampler};
+    }
+
+    //!\copydoc begin()
+    basic_iterator<true> begin() const
+    //!\cond
+        requires const_iterable
+    //!\endcond
+    {
+        return {std::ranges::cbegin(urange), std::ranges::cend(urange), sampler};
+    }
+
+    /*!\brief Returns an iterator to the element following the last element of the range.
+     * \returns Iterator to the end.
+     *
+     * \details
+     *
+     * This element acts as a placeholder; attempting to dereference it results in undefined behaviour.
+     *
+     * ### Complexity
+     *
+     * Constant.
+     *
+     * ### Exceptions
+     *
+     * No-throw guarantee.
+     */
+    sentinel end() const
+    {
+        return {};
+    }
+    //!\}
+};
+
+//!\brief Iterator for calculating modmers.
+template <std::ranges::view urng_t, typename sampler_t>
+template <bool const_range>
+class modmer_view<urng_t, sampler_t>::basic_iterator
+{
+private:
+    //!\brief The sentinel type of the underlying range.
+    using urng_sentinel_t = maybe_const_sentinel_t<const_range, urng_t>;
+    //!\brief The iterator type of the underlying range.
+    using urng_iterator_t = maybe_const_iterator_t<const_range, urng_t>;
+
+    template <bool>
+    friend class basic_iterator;
+
+public:
+    /*!\name Associated types
+     * \{
+     */
+    //!\brief Type for distances between iterators.
+    using difference_type = std::ranges::range_difference_t<urng_t>;
+    //!\brief Value type of this iterator.
+    using value_type = std::ranges::range_value_t<urng_t>;
+    //!\brief The pointer type.
+    using pointer = void;
+    //!\brief Reference to `value_type`.
+    using reference = value_type;
+    //!\brief Tag this class as a forward iterator.
+    using iterator_category = std::forward_iterator_tag;
+    //!\brief Tag this class as a forward iterator.
+    using iterator_concept = iterator_category;
+    //!\}
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    basic_iterator() = default; //!< Defaulted.
+    basic_iterator(basic_iterator const &) = default; //!< Defaulted.
+    basic_iterator(basic_iterator &&) = default; //!< Defaulted.
+    basic_iterator & operator=(basic_iterator const &) = default; //!< Defaulted.
+    basic_iterator & operator=(basic_iterator &&) = default; //!< Defaulted.
+    ~basic_iterator() = default; //!< Defaulted.
+
+    //!\brief Allow iterator on a const range to be constructible from an iterator over a non-const range.
+    basic_iterator(basic_iterator<!const_range> const & it)
+    //!\cond
+        requires const_range
+    //!\endcond
+        : urng_iterator{std::move(it.urng_iterator)},
+          urng_sentinel{std::move(it.urng_sentinel)},
+          sampler{std::move(it.sampler)}
+    {}
+
+    /*!\brief Construct from begin and end iterators of a given range and a sampler.
+    * \param[in] urng_iterator Iterator pointing to the first position of the range.
+    * \param[in] urng_sentinel Iterator pointing to the last position of the range.
+    * \param[in] sampler       The sampler deciding which values are kept.
+    *
+    * \details
+    *
+    * Moves to the first value of the range that is kept by the sampler.
+    */
+    basic_iterator(urng_iterator_t urng_iterator, urng_sentinel_t urng_sentinel, sampler_t sampler) :
+        urng_iterator{std::move(urng_iterator)},
+        urng_sentinel{std::move(urng_sentinel)},
+        sampler{std::move(sampler)}
+    {
+        next_sampled();
+    }
+    //!\}
+
+    //!\anchor basic_iterator_comparison_modmer
+    //!\name Comparison operators
+    //!\{
+
+    //!\brief Compare to another basic_iterator.
+    friend bool operator==(basic_iterator const & lhs, basic_iterator const & rhs)
+    {
+        return lhs.urng_iterator == rhs.urng_iterator;
+    }
+
+    //!\brief Compare to another basic_iterator.
+    friend bool operator!=(basic_iterator const & lhs, basic_iterator const & rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    //!\brief Compare to the sentinel of the modmer_view.
+    friend bool operator==(basic_iterator const & lhs, sentinel const &)
+    {
+        return lhs.urng_iterator == lhs.urng_sentinel;
+    }
+
+    //!\brief Compare to the sentinel of the modmer_view.
+    friend bool operator==(sentinel const & lhs, basic_iterator const & rhs)
+    {
+        return rhs == lhs;
+    }
+
+    //!\brief Compare to the sentinel of the modmer_view.
+    friend bool operator!=(sentinel const & lhs, basic_iterator const & rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    //!\brief Compare to the sentinel of the modmer_view.
+    friend bool operator!=(basic_iterator const & lhs, sentinel const & rhs)
+    {
+        return !(lhs == rhs);
+    }
+    //!\}
+
+    //!\brief Pre-increment.
+    basic_iterator & operator++() noexcept
+    {
+        ++urng_iterator;
+        next_sampled();
+        return *this;
+    }
+
+    //!\brief Post-increment.
+    basic_iterator operator++(int) noexcept
+    {
+        basic_iterator tmp{*this};
+        ++*this;
+        return tmp;
+    }
+
+    //!\brief Return the modmer.
+    value_type operator*() const noexcept
+    {
+        return *urng_iterator;
+    }
+
+private:
+    //!\brief Iterator to the current value.
+    urng_iterator_t urng_iterator{};
+
+    //!\brief Iterator to last element in range.
+    urng_sentinel_t urng_sentinel{};
+
+    //!\brief The sampler deciding which values are kept.
+    sampler_t sampler{};
+
+    //!\brief Advances to the next value that is kept by the sampler, stays if the current value is kept.
+    void next_sampled()
+    {
+        while (urng_iterator != urng_sentinel && !sampler(*urng_iterator))
+            ++urng_iterator;
+    }
+};
+
+//!\brief A deduction guide for the view class template.
+template <std::ranges::viewable_range rng_t, typename sampler_t>
+modmer_view(rng_t &&, sampler_t const sampler) -> modmer_view<std::views::all_t<rng_t>, sampler_t>;
+
+// ---------------------------------------------------------------------------------------------------------------------
+// modmer_fn (adaptor definition)
+// ---------------------------------------------------------------------------------------------------------------------
+
+//![adaptor_def]
+//!\brief modmer's range adaptor object type (non-closure).
+//!\ingroup search_views
+struct modmer_fn
+{
+    //!\brief Store the modulus and return a range adaptor closure object.
+    constexpr auto operator()(uint64_t const mod) const
+    {
+        return adaptor_from_functor{*this, mod};
+    }
+
+    /*!\brief Call the view's constructor with the underlying view and a seqan3::mod_sampler for the given modulus.
+     * \tparam urng_t     The type of the input range to process. Must model std::ranges::viewable_range.
+     * \param[in] urange  The input range to process. Must model std::ranges::viewable_range and
+     *                    std::ranges::forward_range.
+     * \param[in] mod     One in `mod` values is kept.
+     * \throws std::invalid_argument if `mod` is 0 or does not fit into 32 bits.
+     * \returns  A range of the sampled values.
+     */
+    template <std::ranges::range urng_t>
+    constexpr auto operator()(urng_t && urange, uint64_t const mod) const
+    {
+        static_assert(std::ranges::viewable_range<urng_t>,
+                      "The range parameter to views::modmer cannot be a temporary of a non-view range.");
+        static_assert(std::ranges::forward_range<urng_t>,
+                      "The range parameter to views::modmer must model std::ranges::forward_range.");
+
+        return modmer_view{std::forward<urng_t>(urange), seqan3::mod_sampler{mod}};
+    }
+};
+//![adaptor_def]
+
+} // namespace seqan3::detail
+
+namespace seqan3::views
+{
+/*!\brief Computes modmers for a range of hash values. A modmer is a value whose mixed hash is divisible by `mod`.
+ * \tparam urng_t The type of the range being processed. See below for requirements. [template
+ *                 parameter is omitted in pipe notation]
+ * \param[in] urange The range being processed. [parameter is omitted in pipe notation]
+ * \param[in] mod    One in `mod` values is kept.
+ * \returns A range of the sampled values. See below for the properties of the returned range.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * Mod-sampling keeps a fixed fraction 1/`mod` of all values independent of their neighbours, so the density is
+ * predictable, but there is no window guarantee as for minimisers or syncmers. Which values are kept only depends on
+ * the value itself, the same k-mer is therefore sampled in every sequence that contains it.
+ *
+ * ### View properties
+ *
+ * | Concepts and traits              | `urng_t` (underlying range type)   | `rrng_t` (returned range type)   |
+ * |----------------------------------|:----------------------------------:|:--------------------------------:|
+ * | std::ranges::input_range         | *required*                         | *preserved*                      |
+ * | std::ranges::forward_range       | *required*                         | *preserved*                      |
+ * | std::ranges::bidirectional_range |                                    | *lost*                           |
+ * | std::ranges::random_access_range |                                    | *lost*                           |
+ * | std::ranges::contiguous_range    |                                    | *lost*                           |
+ * |                                  |                                    |                                  |
+ * | std::ranges::viewable_range      | *required*                         | *guaranteed*                     |
+ * | std::ranges::view                |                                    | *guaranteed*                     |
+ * | std::ranges::sized_range         |                                    | *lost*                           |
+ * | std::ranges::common_range        |                                    | *lost*                           |
+ * | std::ranges::output_range        |                                    | *lost*                           |
+ * | seqan3::const_iterable_range     |                                    | *preserved*                      |
+ * |                                  |                                    |                                  |
+ * | std::ranges::range_reference_t   | `uint64_t`                         | `uint64_t`                       |
+ *
+ * See the views views submodule documentation for detailed descriptions of the view properties.
+ */
+inline constexpr auto modmer = detail::modmer_fn{};
+
+} // namespace seqan3::views
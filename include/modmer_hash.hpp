@@ -0,0 +1,238 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Hossein Eizadi Moghadam <hosseinem AT fu-berlin.de>
+ * \brief Provides modmer_hash and scaled_syncmer_hash.
+ */
+
+#pragma once
+
+#include <seqan3/core/detail/strong_type.hpp>
+#include <seqan3/search/views/kmer_hash.hpp>
+#include <seqan3/search/views/minimiser_hash.hpp>
+#include "modmer.hpp"
+#include "syncmer_hash.hpp"
+
+namespace seqan3::detail
+{
+//!\brief seqan3::views::modmer_hash's range adaptor object type (non-closure).
+//!\ingroup search_views
+struct modmer_hash_fn
+{
+    /*!\brief Store the shape and the modulus and return a range adaptor closure object.
+    * \param[in] shape       The seqan3::shape to use for hashing.
+    * \param[in] mod         One in `mod` k-mers is kept.
+    * \throws std::invalid_argument if `mod` is 0 or does not fit into 32 bits.
+    * \returns               A range of converted elements.
+    */
+    constexpr auto operator()(shape const & shape, uint64_t const mod) const
+    {
+        return seqan3::detail::adaptor_from_functor{*this, shape, mod};
+    }
+
+    /*!\brief Store the shape, the modulus and the seed and return a range adaptor closure object.
+    * \param[in] shape       The seqan3::shape to use for hashing.
+    * \param[in] mod         One in `mod` k-mers is kept.
+    * \param[in] seed        The seed to use.
+    * \throws std::invalid_argument if `mod` is 0 or does not fit into 32 bits.
+    * \returns               A range of converted elements.
+    */
+    constexpr auto operator()(shape const & shape, uint64_t const mod, seed const seed) const
+    {
+        return seqan3::detail::adaptor_from_functor{*this, shape, mod, seed};
+    }
+
+    /*!\brief Call the view's constructor with the underlying view, a seqan3::shape and a modulus as argument.
+     * \param[in] urange      The input range to process. Must model std::ranges::viewable_range and the reference type
+     *                        of the range must model seqan3::semialphabet.
+     * \param[in] shape       The seqan3::shape to use for hashing.
+     * \param[in] mod         One in `mod` k-mers is kept.
+     * \param[in] seed        The seed to use.
+     * \throws std::invalid_argument if `mod` is 0 or does not fit into 32 bits.
+     * \returns               A range of converted elements.
+     */
+    template <std::ranges::range urng_t>
+    constexpr auto operator()(urng_t && urange,
+                              shape const & shape,
+                              uint64_t const mod,
+                              seed const seed = seqan3::seed{0x8F3F73B5CF1C9ADE}) const
+    {
+        static_assert(std::ranges::viewable_range<urng_t>,
+            "The range parameter to views::modmer_hash cannot be a temporary of a non-view range.");
+        static_assert(std::ranges::forward_range<urng_t>,
+            "The range parameter to views::modmer_hash must model std::ranges::forward_range.");
+        static_assert(semialphabet<std::ranges::range_reference_t<urng_t>>,
+            "The range parameter to views::modmer_hash must be over elements of seqan3::semialphabet.");
+
+        auto forward_strand = std::forward<urng_t>(urange) | seqan3::views::kmer_hash(shape)
+                                                           | std::views::transform([seed] (uint64_t i)
+                                                                                  {return i ^ seed.get();});
+
+        return seqan3::detail::modmer_view(forward_strand, seqan3::mod_sampler{mod});
+    }
+};
+
+//!\brief seqan3::views::scaled_syncmer_hash's range adaptor object type (non-closure).
+//!\ingroup search_views
+struct scaled_syncmer_hash_fn
+{
+    /*!\brief Store the smers, the kmers and the scale factor and return a range adaptor closure object.
+    * \param[in] smers       The S-mer size (s<k) to be used.
+    * \param[in] kmers       The K-mer size to be used.
+    * \param[in] scale       One in `scale` syncmers is kept.
+    * \throws std::invalid_argument if `scale` is 0.
+    * \returns               A range of converted elements.
+    */
+    constexpr auto operator()(size_t const smers, size_t const kmers, uint64_t const scale) const
+    {
+        return seqan3::detail::adaptor_from_functor{*this, smers, kmers, scale};
+    }
+
+    /*!\brief Store the smers, the kmers, the scale factor and the seed and return a range adaptor closure object.
+    * \param[in] smers       The S-mer size (s<k) to be used.
+    * \param[in] kmers       The K-mer size to be used.
+    * \param[in] scale       One in `scale` syncmers is kept.
+    * \param[in] seed        The seed to use.
+    * \throws std::invalid_argument if `scale` is 0.
+    * \returns               A range of converted elements.
+    */
+    constexpr auto operator()(size_t const smers, size_t const kmers, uint64_t const scale, seed const seed) const
+    {
+        return seqan3::detail::adaptor_from_functor{*this, smers, kmers, scale, seed};
+    }
+
+    /*!\brief Call the view's constructor with the syncmers of the underlying view and a scale factor as argument.
+     * \param[in] urange      The input range to process. Must model std::ranges::viewable_range and
+     *                        the reference type of the range must model seqan3::semialphabet.
+     * \param[in] smers       The S-mer size (s<k) to be used.
+     * \param[in] kmers       The K-mer size to be used.
+     * \param[in] scale       One in `scale` syncmers is kept.
+     * \param[in] seed        The seed to use.
+     * \throws std::invalid_argument if `scale` is 0, smers is smaller than 1 or kmers is not larger than smers.
+     * \returns               A range of converted elements.
+     */
+    template <std::ranges::range urng_t>
+    constexpr auto operator()(urng_t && urange,
+                              size_t const smers,
+                              size_t const kmers,
+                              uint64_t const scale,
+                              seed const seed = seqan3::seed{0x8F3F73B5CF1C9ADE}) const
+    {
+        static_assert(std::ranges::viewable_range<urng_t>,
+            "The range parameter to views::scaled_syncmer_hash cannot be a temporary of a non-view range.");
+        static_assert(std::ranges::forward_range<urng_t>,
+            "The range parameter to views::scaled_syncmer_hash must model std::ranges::forward_range.");
+        static_assert(semialphabet<std::ranges::range_reference_t<urng_t>>,
+            "The range parameter to views::scaled_syncmer_hash must be over elements of seqan3::semialphabet.");
+
+        return seqan3::detail::modmer_view(std::forward<urng_t>(urange) | syncmer_hash(smers, kmers, seed),
+                                           seqan3::scaled_sampler{scale});
+    }
+};
+
+} // namespace seqan3::detail
+
+/*!\name Alphabet related views
+ * \{
+ */
+
+/*!\brief                    Computes modmers for a range with a given shape, modulus and seed.
+ * \tparam urng_t            The type of the range being processed. See below for requirements. [template parameter is
+ *                           omitted in pipe notation]
+ * \param[in] urange         The range being processed. [parameter is omitted in pipe notation]
+ * \param[in] shape          The seqan3::shape that determines how to compute the hash value.
+ * \param[in] mod            One in `mod` k-mers is kept.
+ * \param[in] seed           The seed used to skew the hash values. Default: 0x8F3F73B5CF1C9ADE.
+ * \returns                  A range of `size_t` where each value is the hash of a sampled k-mer.
+ *                           See below for the properties of the returned range.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * A k-mer is kept if its mixed hash is divisible by `mod`, see seqan3::mod_sampler. The returned values are the same
+ * k-mer hashes as returned by the other `*_hash` views, so the outputs can be compared directly.
+ *
+ * \attention
+ * Be aware of the requirements of the seqan3::views::kmer_hash view.
+ *
+ *
+ * ### View properties
+ *
+ * | Concepts and traits              | `urng_t` (underlying range type)   | `rrng_t` (returned range type)   |
+ * |----------------------------------|:----------------------------------:|:--------------------------------:|
+ * | std::ranges::input_range         | *required*                         | *preserved*                      |
+ * | std::ranges::forward_range       | *required*                         | *preserved*                      |
+ * | std::ranges::bidirectional_range |                                    | *lost*                           |
+ * | std::ranges::random_access_range |                                    | *lost*                           |
+ * | std::ranges::contiguous_range    |                                    | *lost*                           |
+ * |                                  |                                    |                                  |
+ * | std::ranges::viewable_range      | *required*                         | *guaranteed*                     |
+ * | std::ranges::view                |                                    | *guaranteed*                     |
+ * | std::ranges::sized_range         |                                    | *lost*                           |
+ * | std::ranges::common_range        |                                    | *lost*                           |
+ * | std::ranges::output_range        |                                    | *lost*                           |
+ * | seqan3::const_iterable_range     |                                    | *preserved*                      |
+ * |                                  |                                    |                                  |
+ * | std::ranges::range_reference_t   | seqan3::semialphabet               | std::size_t                      |
+ *
+ * See the views views submodule documentation for detailed descriptions of the view properties.
+ *
+ * \hideinitializer
+ *
+ */
+inline constexpr auto modmer_hash = seqan3::detail::modmer_hash_fn{};
+
+/*!\brief                    Computes closed syncmers and keeps one in `scale` of them (FracMinHash).
+ * \tparam urng_t            The type of the range being processed. See below for requirements. [template parameter is
+ *                           omitted in pipe notation]
+ * \param[in] urange         The range being processed. [parameter is omitted in pipe notation]
+ * \param[in] smers          The S-mer size (s<k) to be used.
+ * \param[in] kmers          The K-mer size to be used.
+ * \param[in] scale          One in `scale` syncmers is kept.
+ * \param[in] seed           The seed used to skew the hash values. Default: 0x8F3F73B5CF1C9ADE.
+ * \returns                  A range of `size_t` where each value is a sampled syncmer.
+ *                           See below for the properties of the returned range.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * The density is the syncmer density divided by `scale`. Because seqan3::scaled_sampler only depends on the hash, a
+ * syncmer that is kept in one sequence is kept in every sequence, and a sketch can be downsampled to a larger scale
+ * later without recomputing it.
+ *
+ * \attention
+ * Be aware of the requirements of the seqan3::views::kmer_hash view.
+ *
+ *
+ * ### View properties
+ *
+ * | Concepts and traits              | `urng_t` (underlying range type)   | `rrng_t` (returned range type)   |
+ * |----------------------------------|:----------------------------------:|:--------------------------------:|
+ * | std::ranges::input_range         | *required*                         | *preserved*                      |
+ * | std::ranges::forward_range       | *required*                         | *preserved*                      |
+ * | std::ranges::bidirectional_range |                                    | *lost*                           |
+ * | std::ranges::random_access_range |                                    | *lost*                           |
+ * | std::ranges::contiguous_range    |                                    | *lost*                           |
+ * |                                  |                                    |                                  |
+ * | std::ranges::viewable_range      | *required*                         | *guaranteed*                     |
+ * | std::ranges::view                |                                    | *guaranteed*                     |
+ * | std::ranges::sized_range         |                                    | *lost*                           |
+ * | std::ranges::common_range        |                                    | *lost*                           |
+ * | std::ranges::output_range        |                                    | *lost*                           |
+ * | seqan3::const_iterable_range     |                                    | *preserved*                      |
+ * |                                  |                                    |                                  |
+ * | std::ranges::range_reference_t   | seqan3::semialphabet               | std::size_t                      |
+ *
+ * See the views views submodule documentation for detailed descriptions of the view properties.
+ *
+ * \hideinitializer
+ *
+ */
+inline constexpr auto scaled_syncmer_hash = seqan3::detail::scaled_syncmer_hash_fn{};
+
+//!\}
@@ -0,0 +1,413 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Hossein Eizadi Moghadam <hosseinem AT fu-berlin.de>
+ * \brief Provides seqan3::multi_seed_syncmer_hash and seqan3::multi_seed_minimiser_hash.
+ */
+
+#pragma once
+
+#include <seqan3/std/algorithm>
+#include <array>
+#include <cstdint>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+#include <seqan3/alphabet/concept.hpp>
+#include <seqan3/search/kmer_index/shape.hpp>
+#include "minimiser_hash.hpp"
+#include "sketch_distance.hpp"
+#include "syncmer.hpp"
+
+namespace seqan3
+{
+namespace detail
+{
+/*!\brief The hash of the last `size` ranks of a text, in the same order as seqan3::views::kmer_hash with an ungapped
+ *        shape: the first rank is the most significant digit.
+ * \tparam sigma The alphabet size.
+ */
+template <uint64_t sigma>
+struct rolling_hash
+{
+    //!\brief The hash of the last `size` ranks.
+    uint64_t value{};
+    //!\brief `sigma^(size - 1)`, the weight of the rank that leaves the hash next.
+    uint64_t roll_factor{1};
+
+    //!\brief Construct for hashes of `size` ranks.
+    explicit rolling_hash(size_t const size)
+    {
+        for (size_t i = 1; i < size; ++i)
+            roll_factor *= sigma;
+    }
+
+    //!\brief Appends `rank`; `leaving` is the rank `size` positions before it, 0 while the hash is filled.
+    void roll(uint64_t const rank, uint64_t const leaving) noexcept
+    {
+        value = (value - leaving * roll_factor) * sigma + rank;
+    }
+};
+
+/*!\brief Searches the smallest value and its position in the window `[start, start + window_size)` for the lanes in
+ *        `mask`; `lane_value(index, lane)` is the value of a lane at an index of the ring buffer of the window.
+ * \tparam leftmost Whether ties are resolved to the first (syncmers) or the last (minimisers) position.
+ * \details The lanes are processed in the innermost loop, so the compiler vectorises the comparisons across seeds.
+ */
+template <bool leftmost, size_t seed_count, typename lane_value_t>
+[[gnu::always_inline]] inline void scan_lanes(size_t const window_size,
+                                              uint64_t const start,
+                                              lane_value_t const & lane_value,
+                                              std::array<bool, seed_count> const & mask,
+                                              std::array<uint64_t, seed_count> & minimum,
+                                              std::array<uint64_t, seed_count> & position)
+{
+    size_t index = start % window_size;
+    std::array<uint64_t, seed_count> best{};
+    std::array<uint64_t, seed_count> best_position{};
+
+    for (size_t lane = 0; lane < seed_count; ++lane)
+    {
+        best[lane] = lane_value(index, lane);
+        best_position[lane] = start;
+    }
+
+    for (uint64_t current = start + 1; current < start + window_size; ++current)
+    {
+        index = index + 1 == window_size ? 0 : index + 1;
+        for (size_t lane = 0; lane < seed_count; ++lane)
+        {
+            uint64_t const value = lane_value(index, lane);
+            bool const take = leftmost ? value < best[lane] : value <= best[lane];
+            best[lane] = take ? value : best[lane];
+            best_position[lane] = take ? current : best_position[lane];
+        }
+    }
+
+    for (size_t lane = 0; lane < seed_count; ++lane)
+    {
+        minimum[lane] = mask[lane] ? best[lane] : minimum[lane];
+        position[lane] = mask[lane] ? best_position[lane] : position[lane];
+    }
+}
+} // namespace detail
+
+/*!\brief Computes the syncmers of a sequence for several seeds in one pass.
+ * \tparam seed_count The number of seeds, e.g. 4 to 16.
+ * \tparam offsets_t  The seqan3::syncmer_offsets at which the smallest s-mer makes a k-mer a syncmer.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * Stream `i` is the output of `sequence | offset_syncmer_hash<offsets_t>(smers, kmers, seed{seeds[i]})`. Running the
+ * view once per seed traverses the text and rolls the k-mer and s-mer hashes once per seed; here they are rolled once
+ * and the seeds are applied to the unseeded s-mer hashes of the window, one lane per seed. The lane loops have no
+ * branches, so the compiler vectorises them; only lanes whose smallest s-mer left the window search the window again,
+ * which is done for all such lanes together. On processors with AVX2 a copy of the loops compiled for AVX2 is selected
+ * at runtime, as in seqan3::intersection_count.
+ *
+ * Sequences with fewer than `kmers` characters have no syncmers.
+ */
+template <size_t seed_count, typename offsets_t = closed_syncmer_offsets>
+class multi_seed_syncmer_hash
+{
+public:
+    static_assert(seed_count > 0, "At least one seed must be given.");
+
+    /*!\brief Construct from the s-mer and k-mer sizes and the seeds.
+     * \throws std::invalid_argument if `smers` is 0 or not smaller than `kmers`, or the offsets do not fit.
+     */
+    multi_seed_syncmer_hash(size_t const smers, size_t const kmers, std::array<uint64_t, seed_count> const & seeds) :
+        smers{smers}, kmers{kmers}, seeds{seeds}
+    {
+        if (smers < 1 || kmers <= smers)
+            throw std::invalid_argument{"The chosen kmers and smers are not valid. "
+                                        "Please choose values greater than 1 and a smer size smaller than the kmer size."};
+
+        syncmer_positions = offsets_t::resolve(kmers - smers + 1);
+        if (std::ranges::any_of(syncmer_positions, [&] (size_t const p) { return p >= kmers - smers + 1; }))
+            throw std::invalid_argument{"The given syncmer offsets do not fit into the given window_size.\n"
+                                        "Please choose a larger window_size or smaller offsets."};
+    }
+
+    /*!\brief Calls `callback(seed_index, hash)` for every syncmer of every seed, in the order of the sequence.
+     * \param[in] sequence A range over seqan3::semialphabet, e.g. seqan3::dna4.
+     * \param[in] callback The function receiving the syncmers.
+     */
+    template <std::ranges::input_range sequence_t, typename callback_t>
+    void operator()(sequence_t && sequence, callback_t && callback) const
+    {
+        using alphabet_t = std::remove_cvref_t<std::ranges::range_reference_t<sequence_t>>;
+        static_assert(semialphabet<alphabet_t>, "The sequence must be over elements of seqan3::semialphabet.");
+
+#if SEQAN3_SKETCH_DISTANCE_AVX2
+        if (detail::has_avx2())
+            return hash_avx2(sequence, callback);
+#endif
+        hash(sequence, callback);
+    }
+
+    //!\brief Returns the syncmers of every seed.
+    template <std::ranges::input_range sequence_t>
+    std::array<std::vector<uint64_t>, seed_count> operator()(sequence_t && sequence) const
+    {
+        std::array<std::vector<uint64_t>, seed_count> streams{};
+        (*this)(std::forward<sequence_t>(sequence), [&streams] (size_t const lane, uint64_t const hash)
+        {
+            streams[lane].push_back(hash);
+        });
+        return streams;
+    }
+
+private:
+    //!\brief The s-mer size.
+    size_t smers{};
+    //!\brief The k-mer size.
+    size_t kmers{};
+    //!\brief The seeds.
+    std::array<uint64_t, seed_count> seeds{};
+    //!\brief The resolved offsets of `offsets_t`.
+    std::array<size_t, offsets_t::size> syncmer_positions{};
+
+#if SEQAN3_SKETCH_DISTANCE_AVX2
+    //!\brief hash() compiled for AVX2, so that the lane loops use 256 bit registers.
+    template <typename sequence_t, typename callback_t>
+    __attribute__((target("avx2")))
+    void hash_avx2(sequence_t & sequence, callback_t & callback) const
+    {
+        hash(sequence, callback);
+    }
+#endif
+
+    //!\brief Computes the syncmers; inlined into the dispatching functions.
+    template <typename sequence_t, typename callback_t>
+    [[gnu::always_inline]] void hash(sequence_t & sequence, callback_t & callback) const
+    {
+        using alphabet_t = std::remove_cvref_t<std::ranges::range_reference_t<sequence_t>>;
+
+        size_t const window_size = kmers - smers + 1;
+        detail::rolling_hash<alphabet_size<alphabet_t>> smer_hash{smers};
+        detail::rolling_hash<alphabet_size<alphabet_t>> kmer_hash{kmers};
+        std::vector<uint8_t> ranks(kmers);
+        size_t rank_index{0};
+        std::vector<uint64_t> ring(window_size);
+        std::array<uint64_t, seed_count> minimum{};
+        std::array<uint64_t, seed_count> position{};
+        std::array<bool, seed_count> expired{};
+        auto const lane_value = [&] (size_t const index, size_t const lane) { return ring[index] ^ seeds[lane]; };
+
+        uint64_t i{0};
+        for (auto const & character : sequence)
+        {
+            uint8_t const rank = seqan3::to_rank(character);
+            size_t const smer_index = rank_index >= smers ? rank_index - smers : rank_index + kmers - smers;
+            kmer_hash.roll(rank, i >= kmers ? ranks[rank_index] : 0);
+            smer_hash.roll(rank, i >= smers ? ranks[smer_index] : 0);
+            ranks[rank_index] = rank;
+            rank_index = rank_index + 1 == kmers ? 0 : rank_index + 1;
+
+            if (++i < smers)
+                continue;
+
+            // The s-mer `current` ends at this character, the window of the k-mer ending here starts at `start`.
+            uint64_t const current = i - smers;
+            ring[current % window_size] = smer_hash.value;
+            if (current + 1 < window_size)
+                continue;
+
+            uint64_t const start = current + 1 - window_size;
+            if (start == 0)
+            {
+                expired.fill(true);
+                detail::scan_lanes<true>(window_size, start, lane_value, expired, minimum, position);
+            }
+            else
+            {
+                bool any_expired{false};
+                for (size_t lane = 0; lane < seed_count; ++lane)
+                {
+                    uint64_t const value = smer_hash.value ^ seeds[lane];
+                    bool const smaller = value < minimum[lane];
+                    minimum[lane] = smaller ? value : minimum[lane];
+                    position[lane] = smaller ? current : position[lane];
+                    expired[lane] = position[lane] < start;
+                    any_expired |= expired[lane];
+                }
+
+                if (any_expired)
+                    detail::scan_lanes<true>(window_size, start, lane_value, expired, minimum, position);
+            }
+
+            for (size_t lane = 0; lane < seed_count; ++lane)
+                if (is_syncmer_position(position[lane] - start))
+                    callback(lane, kmer_hash.value ^ seeds[lane]);
+        }
+    }
+
+    //!\brief Whether the smallest s-mer at `offset` makes the k-mer a syncmer; unrolled without branches.
+    [[gnu::always_inline]] bool is_syncmer_position(uint64_t const offset) const noexcept
+    {
+        return [&] <size_t ...idx> (std::index_sequence<idx...>)
+        {
+            return ((offset == syncmer_positions[idx]) | ...);
+        }(std::make_index_sequence<offsets_t::size>{});
+    }
+};
+
+/*!\brief Computes the minimisers of a nucleotide sequence for several seeds in one pass.
+ * \tparam seed_count The number of seeds, e.g. 4 to 16.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * Stream `i` is the output of `sequence | seqan3::views::minimiser_hash(shape, window_size, seed{seeds[i]})` for an
+ * ungapped shape: the smallest of the seeded forward and reverse complement hashes of the window, reported when it
+ * changes. The forward and reverse complement hashes are rolled once, both are stored per window position and every
+ * lane applies its seed to them, as in seqan3::multi_seed_syncmer_hash.
+ *
+ * Sequences with fewer than `window_size` characters have no minimisers.
+ */
+template <size_t seed_count>
+class multi_seed_minimiser_hash
+{
+public:
+    static_assert(seed_count > 0, "At least one seed must be given.");
+
+    /*!\brief Construct from an ungapped shape, the window size and the seeds.
+     * \throws std::invalid_argument if the shape is gapped, longer than 32 or longer than the window.
+     */
+    multi_seed_minimiser_hash(shape const & shape_,
+                              window_size const window,
+                              std::array<uint64_t, seed_count> const & seeds) :
+        shape_size{shape_.size()}, window{window.get()}, seeds{seeds}
+    {
+        if (shape_.count() != shape_.size() || shape_size > 32)
+            throw std::invalid_argument{"The chosen shape is not valid. Please choose an ungapped shape of at most 32."};
+
+        if (shape_size > window.get())
+            throw std::invalid_argument{"The size of the shape cannot be greater than the window size."};
+    }
+
+    /*!\brief Calls `callback(seed_index, hash)` for every minimiser of every seed, in the order of the sequence.
+     * \param[in] sequence A range over a nucleotide alphabet of size 4, e.g. seqan3::dna4.
+     * \param[in] callback The function receiving the minimisers.
+     */
+    template <std::ranges::input_range sequence_t, typename callback_t>
+    void operator()(sequence_t && sequence, callback_t && callback) const
+    {
+        using alphabet_t = std::remove_cvref_t<std::ranges::range_reference_t<sequence_t>>;
+        static_assert(alphabet_size<alphabet_t> == 4,
+                      "The sequence must be over a nucleotide alphabet of size 4, e.g. seqan3::dna4.");
+
+#if SEQAN3_SKETCH_DISTANCE_AVX2
+        if (detail::has_avx2())
+            return hash_avx2(sequence, callback);
+#endif
+        hash(sequence, callback);
+    }
+
+    //!\brief Returns the minimisers of every seed.
+    template <std::ranges::input_range sequence_t>
+    std::array<std::vector<uint64_t>, seed_count> operator()(sequence_t && sequence) const
+    {
+        std::array<std::vector<uint64_t>, seed_count> streams{};
+        (*this)(std::forward<sequence_t>(sequence), [&streams] (size_t const lane, uint64_t const hash)
+        {
+            streams[lane].push_back(hash);
+        });
+        return streams;
+    }
+
+private:
+    //!\brief The shape size.
+    size_t shape_size{};
+    //!\brief The window size.
+    size_t window{};
+    //!\brief The seeds.
+    std::array<uint64_t, seed_count> seeds{};
+
+#if SEQAN3_SKETCH_DISTANCE_AVX2
+    //!\brief hash() compiled for AVX2, so that the lane loops use 256 bit registers.
+    template <typename sequence_t, typename callback_t>
+    __attribute__((target("avx2")))
+    void hash_avx2(sequence_t & sequence, callback_t & callback) const
+    {
+        hash(sequence, callback);
+    }
+#endif
+
+    //!\brief Computes the minimisers; inlined into the dispatching functions.
+    template <typename sequence_t, typename callback_t>
+    [[gnu::always_inline]] void hash(sequence_t & sequence, callback_t & callback) const
+    {
+
+        size_t const window_size = window - shape_size + 1;
+        uint64_t const mask = shape_size == 32 ? ~uint64_t{0} : (uint64_t{1} << (2 * shape_size)) - 1;
+        uint64_t forward{0};
+        uint64_t reverse{0};
+        std::vector<uint64_t> forward_ring(window_size);
+        std::vector<uint64_t> reverse_ring(window_size);
+        std::array<uint64_t, seed_count> minimum{};
+        std::array<uint64_t, seed_count> position{};
+        std::array<bool, seed_count> expired{};
+        std::array<bool, seed_count> report{};
+        auto const lane_value = [&] (size_t const index, size_t const lane)
+        {
+            return std::min(forward_ring[index] ^ seeds[lane], reverse_ring[index] ^ seeds[lane]);
+        };
+
+        uint64_t i{0};
+        for (auto const & character : sequence)
+        {
+            uint64_t const rank = seqan3::to_rank(character);
+            forward = ((forward << 2) | rank) & mask;
+            reverse = (reverse >> 2) | ((3 - rank) << (2 * (shape_size - 1)));
+
+            if (++i < shape_size)
+                continue;
+
+            uint64_t const current = i - shape_size;
+            forward_ring[current % window_size] = forward;
+            reverse_ring[current % window_size] = reverse;
+            if (current + 1 < window_size)
+                continue;
+
+            uint64_t const start = current + 1 - window_size;
+            if (start == 0)
+            {
+                expired.fill(true);
+                report.fill(true);
+                detail::scan_lanes<false>(window_size, start, lane_value, expired, minimum, position);
+            }
+            else
+            {
+                // A lane reports when its minimiser is replaced by the new value or has to be searched again.
+                bool any_expired{false};
+                for (size_t lane = 0; lane < seed_count; ++lane)
+                {
+                    uint64_t const value = std::min(forward ^ seeds[lane], reverse ^ seeds[lane]);
+                    bool const smaller = value < minimum[lane];
+                    minimum[lane] = smaller ? value : minimum[lane];
+                    position[lane] = smaller ? current : position[lane];
+                    expired[lane] = position[lane] < start;
+                    report[lane] = smaller | expired[lane];
+                    any_expired |= expired[lane];
+                }
+
+                if (any_expired)
+                    detail::scan_lanes<false>(window_size, start, lane_value, expired, minimum, position);
+            }
+
+            for (size_t lane = 0; lane < seed_count; ++lane)
+                if (report[lane])
+                    callback(lane, minimum[lane]);
+        }
+    }
+};
+} // namespace seqan3
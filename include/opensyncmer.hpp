@@ -13,7 +13,6 @@
 #pragma once
 
 #include <seqan3/std/algorithm>
-#include <deque>
 
 #include <seqan3/core/detail/empty_type.hpp>
 #include <seqan3/core/range/detail/adaptor_from_functor.hpp>
@@ -21,6 +20,9 @@
 #include <seqan3/utility/range/concept.hpp>
 #include <seqan3/utility/type_traits/lazy_conditional.hpp>
 
+#include "sampling_stats.hpp"
+#include "window_buffer.hpp"
+
 namespace seqan3::detail
 {
 // ---------------------------------------------------------------------------------------------------------------------
@@ -174,6 +176,16 @@ public:
         return {};
     }
     //!\}
+
+    /*!\brief Traverses the view and returns the counters of its iterator, see seqan3::sampling_stats.
+     * \details All counters are 0 unless SEQAN3_SAMPLING_STATS is 1.
+     */
+    sampling_stats stats()
+    {
+        auto it = begin();
+        for (; it != end(); ++it) {}
+        return it.stats();
+    }
 };
 
 //!\brief Iterator for calculating opensyncmers.
@@ -320,6 +332,12 @@ public:
         return opensyncmer_value;
     }
 
+    //!\brief The work of the traversal so far; all counters are 0 unless SEQAN3_SAMPLING_STATS is 1.
+    sampling_stats stats() const noexcept
+    {
+        return counters.stats();
+    }
+
 private:
     //!\brief The opensyncmer value.
     value_type opensyncmer_value{};
@@ -340,7 +358,10 @@ private:
     size_t w_size{};
 
     //!\brief Stored values per window. It is necessary to store them, because a shift can remove the current opensyncmer.
-    std::deque<value_type> window_values{};
+    window_buffer<value_type> window_values{};
+
+    //!\brief The counters of stats().
+    [[no_unique_address]] detail::sampling_counters<> counters{};
 
     //!\brief Increments iterator by 1.
     void next_unique_opensyncmer()
@@ -387,6 +408,9 @@ private:
 
         auto smallest_s_it = std::ranges::min_element(window_values, std::less<value_type>{});
 	    opensyncmer_position_offset = std::distance(std::begin(window_values), smallest_s_it);
+        counters.position();
+        counters.rescan(window_values.size());
+        counters.sample();
 
 	if (opensyncmer_position_offset == 0) {
 		auto opensyncmer_it = urng2_iterator;
@@ -410,6 +434,7 @@ private:
             return true;
 
         value_type const new_value = window_value();
+        counters.position();
 
         window_values.pop_front();
         window_values.push_back(new_value);
@@ -420,11 +445,13 @@ private:
 		auto smallest_s_it = std::ranges::min_element(window_values, std::less<value_type>{});
 
 		opensyncmer_position_offset = std::distance(std::begin(window_values), smallest_s_it);
+		counters.rescan(window_values.size());
 
 		if (opensyncmer_position_offset == 0) {
 
 			auto opensyncmer_it = urng2_iterator;
 			opensyncmer_value = *opensyncmer_it;
+			counters.sample();
 			return true;
 		};
 	}
@@ -438,9 +465,14 @@ private:
 		  auto opensyncmer_it = urng2_iterator;
 		  opensyncmer_value = *opensyncmer_it;
 		  --opensyncmer_position_offset;
+		  counters.tie(new_value == window_values.front());
+		  counters.sample();
 		  return true;
-	 };
-
+	 }
+	 else
+	 {
+		  counters.tie(new_value == *(window_values.begin()+(opensyncmer_position_offset-1)));
+	 }
 
 
 	--opensyncmer_position_offset;
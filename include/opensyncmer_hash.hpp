@@ -87,7 +87,7 @@ struct opensyncmer_hash_fn
                                                           {return i ^ seed.get();});
 
 
-        return seqan3::detail::syncmer_view<decltype(smers_hash), decltype(kmers_hash), true>
+        return seqan3::detail::syncmer_view<decltype(smers_hash), decltype(kmers_hash), seqan3::open_syncmer_offsets>
                                                  (smers_hash, kmers_hash, kmers - smers + 1);
     }
 };
@@ -119,14 +119,14 @@ struct opensyncmer_hash_fn
  * |----------------------------------|:----------------------------------:|:--------------------------------:|
  * | std::ranges::input_range         | *required*                         | *preserved*                      |
  * | std::ranges::forward_range       | *required*                         | *preserved*                      |
- * | std::ranges::bidirectional_range |                                    | *lost*                           |
+ * | std::ranges::bidirectional_range |                                    | *preserved*                      |
  * | std::ranges::random_access_range |                                    | *lost*                           |
  * | std::ranges::contiguous_range    |                                    | *lost*                           |
  * |                                  |                                    |                                  |
  * | std::ranges::viewable_range      | *required*                         | *guaranteed*                     |
  * | std::ranges::view                |                                    | *guaranteed*                     |
  * | std::ranges::sized_range         |                                    | *lost*                           |
- * | std::ranges::common_range        |                                    | *lost*                           |
+ * | std::ranges::common_range        |                                    | *preserved*                      |
  * | std::ranges::output_range        |                                    | *lost*                           |
  * | seqan3::const_iterable_range     |                                    | *preserved*                      |
  * |                                  |                                    |                                  |
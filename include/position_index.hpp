@@ -0,0 +1,368 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Hossein Eizadi Moghadam <hosseinem AT fu-berlin.de>
+ * \brief Provides seqan3::position_index.
+ */
+
+#pragma once
+
+#include <seqan3/std/algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace seqan3
+{
+/*!\brief A compact index from sampled hashes, e.g. of seqan3::views::syncmer_hash, to their positions.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * Hashes of k-mers only differ in their lowest 2k bits. The index stores the bits common to all hashes once and
+ * spreads the remaining `key_bits` bits with a bijection, the leading bits of the spread key select a bucket. Every
+ * (hash, position) pair is one entry of the remaining key bits and the position bits, bit-packed in the order of the
+ * spread key, and a directory of 32 bit offsets gives the first entry of each bucket. There is on average one bucket
+ * per four to eight entries, so a query reads one directory word and the one or two cache lines of its bucket.
+ *
+ * For `n` entries, an entry needs about `2k - log2(n / 8) + log2(max position)` bits and the directory at most 1 byte
+ * per entry; for k <= 31 and at least one sampled position per 16 text positions this is less than 10 bytes per
+ * position. A hash occurring several times simply has several consecutive entries, so there is no separate offsets
+ * array for repeated hashes.
+ *
+ * The index is built from (hash, position) pairs by a parallel counting sort on the bucket followed by a sort of each
+ * bucket. Queries are thread-safe, the batch query overlaps the cache misses of several
+ * hashes.
+ */
+class position_index
+{
+public:
+    //!\brief The type of the stored positions.
+    using position_type = uint32_t;
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    position_index() = default; //!< Defaulted.
+    position_index(position_index const &) = default; //!< Defaulted.
+    position_index(position_index &&) = default; //!< Defaulted.
+    position_index & operator=(position_index const &) = default; //!< Defaulted.
+    position_index & operator=(position_index &&) = default; //!< Defaulted.
+    ~position_index() = default; //!< Defaulted.
+
+    /*!\brief Construct from (hash, position) pairs.
+     * \param[in] pairs   The hashes and their positions, in any order.
+     * \param[in] threads The number of threads used for the construction. Default: 1.
+     * \throws std::invalid_argument if `threads` is 0 or there are 2^32 or more pairs.
+     */
+    explicit position_index(std::span<std::pair<uint64_t, position_type> const> pairs, size_t const threads = 1)
+    {
+        if (threads == 0)
+            throw std::invalid_argument{"The chosen number of threads is not valid. "
+                                        "Please choose a value greater than 0."};
+
+        if (pairs.size() >= std::numeric_limits<uint32_t>::max())
+            throw std::invalid_argument{"The position_index can store less than 2^32 positions."};
+
+        size_t const size = pairs.size();
+        entry_count = size;
+        if (size == 0)
+        {
+            directory.assign(2, 0);
+            return;
+        }
+
+        // Bits that differ between the hashes and the largest position.
+        std::vector<std::pair<uint64_t, position_type>> thread_bits(threads, {0, 0});
+        parallel_for(threads, size, [&] (size_t const thread, size_t const first, size_t const last)
+        {
+            for (size_t i = first; i < last; ++i)
+            {
+                thread_bits[thread].first |= pairs[i].first ^ pairs[0].first;
+                thread_bits[thread].second = std::max(thread_bits[thread].second, pairs[i].second);
+            }
+        });
+
+        uint64_t varying_bits{0};
+        position_type max_position{0};
+        for (auto const & [hash_bits, position] : thread_bits)
+        {
+            varying_bits |= hash_bits;
+            max_position = std::max(max_position, position);
+        }
+
+        key_bits = std::bit_width(varying_bits);
+        key_mask = key_bits == 64 ? std::numeric_limits<uint64_t>::max() : (uint64_t{1} << key_bits) - 1;
+        common_bits = pairs[0].first & ~key_mask;
+        bucket_bits = std::min<size_t>(key_bits, std::max<int>(std::bit_width(size) - 3, 0));
+        remainder_bits = key_bits - bucket_bits;
+        position_bits = std::bit_width(max_position);
+        entry_bits = remainder_bits + position_bits;
+
+        size_t const bucket_count = size_t{1} << bucket_bits;
+
+        // Counting sort on the bucket, every thread scatters its chunk to its own offsets.
+        std::vector<std::pair<uint64_t, position_type>> sorted(size);
+        std::vector<std::vector<uint32_t>> thread_offsets(threads, std::vector<uint32_t>(bucket_count, 0));
+
+        parallel_for(threads, size, [&] (size_t const thread, size_t const first, size_t const last)
+        {
+            for (size_t i = first; i < last; ++i)
+                ++thread_offsets[thread][bucket(spread(pairs[i].first & key_mask))];
+        });
+
+        directory.resize(bucket_count + 1);
+        uint32_t offset{0};
+        for (size_t id = 0; id < bucket_count; ++id)
+        {
+            directory[id] = offset;
+            for (size_t thread = 0; thread < threads; ++thread)
+                offset += std::exchange(thread_offsets[thread][id], offset);
+        }
+        directory[bucket_count] = offset;
+
+        parallel_for(threads, size, [&] (size_t const thread, size_t const first, size_t const last)
+        {
+            for (size_t i = first; i < last; ++i)
+            {
+                uint64_t const key = spread(pairs[i].first & key_mask);
+                sorted[thread_offsets[thread][bucket(key)]++] = {key, pairs[i].second};
+            }
+        });
+        thread_offsets.clear();
+
+        parallel_for(threads, bucket_count, [&] (size_t, size_t const first, size_t const last)
+        {
+            for (size_t id = first; id < last; ++id)
+                std::sort(sorted.begin() + directory[id], sorted.begin() + directory[id + 1]);
+        });
+
+        // Each thread packs a multiple of 64 entries, so the chunks start at word boundaries.
+        entries.assign((size * entry_bits + 63) / 64 + 1, 0);
+        parallel_for(threads, (size + 63) / 64, [&] (size_t, size_t const first, size_t const last)
+        {
+            for (size_t i = first * 64; i < std::min(last * 64, size); ++i)
+            {
+                write_bits(i * entry_bits, remainder_bits, sorted[i].first);
+                write_bits(i * entry_bits + remainder_bits, position_bits, sorted[i].second);
+            }
+        });
+    }
+    //!\}
+
+    //!\brief The number of stored positions.
+    size_t size() const noexcept
+    {
+        return entry_count;
+    }
+
+    //!\brief The number of bytes of the index.
+    size_t size_in_bytes() const noexcept
+    {
+        return sizeof(position_index) + directory.size() * sizeof(uint32_t) + entries.size() * sizeof(uint64_t);
+    }
+
+    //!\brief The number of positions of `hash`.
+    size_t count(uint64_t const hash) const noexcept
+    {
+        size_t result{0};
+        for_each_position(hash, [&result] (position_type) { ++result; });
+        return result;
+    }
+
+    /*!\brief Appends the positions of `hash` to `positions`, in increasing order.
+     * \param[in]     hash      The hash to look up.
+     * \param[in,out] positions The positions are appended to this vector.
+     */
+    void locate(uint64_t const hash, std::vector<position_type> & positions) const
+    {
+        for_each_position(hash, [&positions] (position_type const position) { positions.push_back(position); });
+    }
+
+    /*!\brief Looks up several hashes, the positions of `hashes[i]` are `positions[offsets[i]]` to
+     *        `positions[offsets[i + 1] - 1]`.
+     * \param[in]  hashes    The hashes to look up, e.g. the syncmers of a read.
+     * \param[out] positions The positions of all hashes; cleared first.
+     * \param[out] offsets   The first position of each hash and the total number of positions; cleared first.
+     *
+     * \details
+     *
+     * The hashes are processed in blocks of `batch_size`: first the directory words of all hashes of a block are
+     * loaded, then the first entries of their buckets are prefetched and only then the buckets are scanned. The loads
+     * of one stage do not depend on each other, so the cache misses of a block overlap instead of being serialised by
+     * the data dependent branches of the scans.
+     */
+    void locate(std::span<uint64_t const> hashes,
+                std::vector<position_type> & positions,
+                std::vector<size_t> & offsets) const
+    {
+        positions.clear();
+        offsets.clear();
+        offsets.reserve(hashes.size() + 1);
+
+        std::array<uint64_t, batch_size> keys{};
+        std::array<uint32_t, batch_size> firsts{};
+        std::array<uint32_t, batch_size> lasts{};
+        auto append = [&positions] (position_type const position) { positions.push_back(position); };
+
+        for (size_t block = 0; block < hashes.size(); block += batch_size)
+        {
+            size_t const count = std::min(batch_size, hashes.size() - block);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                keys[i] = spread(hashes[block + i] & key_mask);
+                size_t const id = bucket(keys[i]);
+                firsts[i] = directory[id];
+                lasts[i] = directory[id + 1];
+            }
+
+            for (size_t i = 0; i < count; ++i)
+                __builtin_prefetch(entries.data() + firsts[i] * entry_bits / 64);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                offsets.push_back(positions.size());
+                if (entry_count != 0 && (hashes[block + i] & ~key_mask) == common_bits)
+                    scan(keys[i], firsts[i], lasts[i], append);
+            }
+        }
+        offsets.push_back(positions.size());
+    }
+
+    /*!\brief Calls `callback` with every position of `hash`, in increasing order.
+     * \param[in] hash     The hash to look up.
+     * \param[in] callback Called with a `position_type`.
+     */
+    template <typename callback_t>
+    void for_each_position(uint64_t const hash, callback_t && callback) const
+    {
+        if (entry_count == 0 || (hash & ~key_mask) != common_bits)
+            return;
+
+        uint64_t const key = spread(hash & key_mask);
+        size_t const id = bucket(key);
+        scan(key, directory[id], directory[id + 1], callback);
+    }
+
+private:
+    //!\brief The number of hashes whose lookups overlap in the batch query.
+    static constexpr size_t batch_size{32};
+
+    //!\brief The number of stored positions.
+    size_t entry_count{0};
+    //!\brief The number of hash bits that differ between the stored hashes.
+    size_t key_bits{0};
+    //!\brief The mask of the lowest `key_bits` bits.
+    uint64_t key_mask{0};
+    //!\brief The bits above `key_bits` shared by all stored hashes.
+    uint64_t common_bits{0};
+    //!\brief The number of leading bits of a spread key that select its bucket.
+    size_t bucket_bits{0};
+    //!\brief The number of bits of a spread key stored in an entry.
+    size_t remainder_bits{0};
+    //!\brief The number of bits of a position.
+    size_t position_bits{0};
+    //!\brief The number of bits of an entry.
+    size_t entry_bits{0};
+    //!\brief The first entry of every bucket and the number of entries.
+    std::vector<uint32_t> directory{0, 0};
+    //!\brief The bit-packed entries, padded by one word so that every read can load two words.
+    std::vector<uint64_t> entries{};
+
+    //!\brief Calls `callback` with the positions of the entries in `[first, last)` whose remainder matches `key`.
+    template <typename callback_t>
+    void scan(uint64_t const key, size_t const first, size_t const last, callback_t && callback) const
+    {
+        uint64_t const remainder = key & remainder_mask();
+
+        for (size_t i = first; i < last; ++i)
+        {
+            uint64_t const entry_remainder = read_bits(i * entry_bits, remainder_bits);
+            if (entry_remainder > remainder)
+                break;
+            if (entry_remainder == remainder)
+                callback(static_cast<position_type>(read_bits(i * entry_bits + remainder_bits, position_bits)));
+        }
+    }
+
+    //!\brief Calls `function(thread, first, last)` for `threads` consecutive chunks of `[0, count)`.
+    template <typename function_t>
+    static void parallel_for(size_t const threads, size_t const count, function_t && function)
+    {
+        if (threads == 1)
+        {
+            function(0, 0, count);
+            return;
+        }
+
+        std::vector<std::jthread> workers{};
+        workers.reserve(threads);
+        for (size_t thread = 0; thread < threads; ++thread)
+            workers.emplace_back(function, thread, count * thread / threads, count * (thread + 1) / threads);
+    }
+
+    //!\brief A bijection on the lowest `key_bits` bits that spreads them over the leading bits.
+    uint64_t spread(uint64_t key) const noexcept
+    {
+        size_t const shift = (key_bits + 1) / 2;
+        key ^= key >> shift;
+        key = (key * 0x9E3779B97F4A7C15ULL) & key_mask;
+        key ^= key >> shift;
+        return key;
+    }
+
+    //!\brief The bucket of a spread key.
+    size_t bucket(uint64_t const key) const noexcept
+    {
+        return bucket_bits == 0 ? 0 : key >> remainder_bits;
+    }
+
+    //!\brief The mask of the lowest `remainder_bits` bits.
+    uint64_t remainder_mask() const noexcept
+    {
+        return remainder_bits == 64 ? std::numeric_limits<uint64_t>::max() : (uint64_t{1} << remainder_bits) - 1;
+    }
+
+    //!\brief Reads `width` <= 64 bits starting at bit `offset`.
+    uint64_t read_bits(size_t const offset, size_t const width) const noexcept
+    {
+        if (width == 0)
+            return 0;
+
+        size_t const word = offset / 64;
+        size_t const shift = offset % 64;
+        uint64_t value = entries[word] >> shift;
+        if (shift != 0)
+            value |= entries[word + 1] << (64 - shift);
+        return width == 64 ? value : value & ((uint64_t{1} << width) - 1);
+    }
+
+    //!\brief Writes the lowest `width` <= 64 bits of `value` starting at bit `offset` into zeroed words.
+    void write_bits(size_t const offset, size_t const width, uint64_t value) noexcept
+    {
+        if (width == 0)
+            return;
+
+        if (width < 64)
+            value &= (uint64_t{1} << width) - 1;
+
+        size_t const word = offset / 64;
+        size_t const shift = offset % 64;
+        entries[word] |= value << shift;
+        if (shift + width > 64)
+            entries[word + 1] |= value >> (64 - shift);
+    }
+};
+} // namespace seqan3
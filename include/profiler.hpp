@@ -0,0 +1,438 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Hossein Eizadi Moghadam <hosseinem AT fu-berlin.de>
+ * \brief Provides seqan3::profiler and seqan3::scoped_timer.
+ */
+
+#pragma once
+
+#include <seqan3/std/algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace seqan3
+{
+namespace detail
+{
+//!\brief The time stamp counter, or the nanoseconds of the steady clock on processors without one.
+inline uint64_t read_cycles() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+//!\brief The calls of one stage on one thread.
+struct stage_accumulator
+{
+    //!\brief The number of calls.
+    uint64_t calls{};
+    //!\brief The ticks of all calls.
+    uint64_t ticks{};
+    //!\brief The number of items, e.g. bases or records, of all calls.
+    uint64_t items{};
+    //!\brief The ticks of the shortest call.
+    uint64_t min_ticks{std::numeric_limits<uint64_t>::max()};
+    //!\brief The ticks of the longest call.
+    uint64_t max_ticks{};
+    //!\brief `histogram[i]` is the number of calls with `std::bit_width(ticks) == i`, i.e. in `[2^(i-1), 2^i)`.
+    std::array<uint64_t, 65> histogram{};
+
+    //!\brief Adds a call.
+    void add(uint64_t const duration, uint64_t const call_items) noexcept
+    {
+        ++calls;
+        ticks += duration;
+        items += call_items;
+        min_ticks = std::min(min_ticks, duration);
+        max_ticks = std::max(max_ticks, duration);
+        ++histogram[std::bit_width(duration)];
+    }
+
+    //!\brief Adds the calls of another thread.
+    void merge(stage_accumulator const & other) noexcept
+    {
+        calls += other.calls;
+        ticks += other.ticks;
+        items += other.items;
+        min_ticks = std::min(min_ticks, other.min_ticks);
+        max_ticks = std::max(max_ticks, other.max_ticks);
+        for (size_t i = 0; i < histogram.size(); ++i)
+            histogram[i] += other.histogram[i];
+    }
+};
+
+//!\brief One call of a stage for the Chrome trace.
+struct trace_event
+{
+    //!\brief The stage.
+    uint32_t stage{};
+    //!\brief The counter at the start.
+    uint64_t begin{};
+    //!\brief The counter at the end.
+    uint64_t end{};
+};
+
+//!\brief The calls recorded by one thread.
+struct thread_profile
+{
+    //!\brief The number of the thread in the order of its first call.
+    uint32_t thread{};
+    //!\brief The calls per stage.
+    std::vector<stage_accumulator> stages{};
+    //!\brief The calls in order, if the profiler traces.
+    std::vector<trace_event> events{};
+    //!\brief The number of calls not traced because `events` was full.
+    uint64_t dropped_events{};
+};
+} // namespace detail
+
+/*!\brief Collects the time per stage of a pipeline, e.g. parsing, rank conversion, hashing, sampling and index
+ *        insertion, from any number of threads.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * Stages are registered by name with stage() and timed with seqan3::scoped_timer, or with record() for intervals
+ * that do not match a scope. A call costs two reads of the time stamp counter and an update of accumulators owned by
+ * the calling thread, without locks or shared cache lines; when the profiler is not enabled, a scoped timer only
+ * reads one flag. Every accumulator keeps the number of calls, ticks and items and a histogram of the ticks per call
+ * with power of two buckets, from which write_json() reports the median and 99th percentile as upper bounds.
+ *
+ * The accumulators of a thread are merged into the profiler when the thread ends, e.g. when the threads of
+ * seqan3::build_ibf are joined; write_json() and write_chrome_trace() additionally merge those of running threads,
+ * which must not record at the same time. Ticks are converted to seconds with the rate of the counter measured
+ * between enable() and the output.
+ *
+ * With tracing enabled every call is also stored, up to `max_events` per thread, for write_chrome_trace(), whose
+ * output is opened in chrome://tracing or Perfetto to find stalls between stages.
+ */
+class profiler
+{
+public:
+    //!\brief The number of calls traced per thread.
+    static constexpr size_t max_events = 1 << 20;
+
+    //!\brief The profiler that seqan3::scoped_timer reports into.
+    static profiler & global()
+    {
+        static profiler instance{};
+        return instance;
+    }
+
+    //!\brief Starts recording, with or without the calls for write_chrome_trace().
+    void enable(bool const trace = false)
+    {
+        std::lock_guard lock{mutex};
+        start_cycles = detail::read_cycles();
+        start_time = std::chrono::steady_clock::now();
+        tracing.store(trace, std::memory_order_relaxed);
+        active.store(true, std::memory_order_relaxed);
+    }
+
+    //!\brief Stops recording.
+    void disable() noexcept
+    {
+        active.store(false, std::memory_order_relaxed);
+    }
+
+    //!\brief Whether the profiler records.
+    bool enabled() const noexcept
+    {
+        return active.load(std::memory_order_relaxed);
+    }
+
+    //!\brief Returns the id of the stage `name`, registering it on the first call.
+    size_t stage(std::string_view const name)
+    {
+        std::lock_guard lock{mutex};
+        auto it = std::ranges::find(stage_names, name);
+        if (it != stage_names.end())
+            return it - stage_names.begin();
+
+        stage_names.emplace_back(name);
+        return stage_names.size() - 1;
+    }
+
+    //!\brief Records a call of `stage` between two values of detail::read_cycles() that processed `items` items.
+    void record(size_t const stage, uint64_t const begin, uint64_t const end, uint64_t const items = 0)
+    {
+        if (!enabled())
+            return;
+
+        detail::thread_profile & profile = local().profile;
+        if (stage >= profile.stages.size())
+            profile.stages.resize(stage + 1);
+        profile.stages[stage].add(end - begin, items);
+
+        if (tracing.load(std::memory_order_relaxed))
+        {
+            if (profile.events.size() < max_events)
+                profile.events.push_back({static_cast<uint32_t>(stage), begin, end});
+            else
+                ++profile.dropped_events;
+        }
+    }
+
+    /*!\brief Writes the stages as JSON.
+     * \details An object with `ticks_per_second`, `wall_seconds`, `threads` and `stages`, an array of objects with
+     *          `name`, `calls`, `seconds`, `items`, `items_per_second`, `min_ticks`, `median_ticks`, `p99_ticks`,
+     *          `max_ticks` and `histogram`, the non-empty buckets as pairs of the upper bound in ticks and the count.
+     */
+    void write_json(std::ostream & stream)
+    {
+        std::lock_guard lock{mutex};
+        std::vector<detail::stage_accumulator> stages(stage_names.size());
+        size_t threads{};
+        for_each_profile([&] (detail::thread_profile const & profile)
+        {
+            ++threads;
+            for (size_t stage = 0; stage < profile.stages.size(); ++stage)
+                stages[stage].merge(profile.stages[stage]);
+        });
+
+        double const rate = ticks_per_second();
+        stream << "{\n  \"ticks_per_second\": " << rate << ",\n  \"wall_seconds\": " << wall_seconds()
+               << ",\n  \"threads\": " << threads << ",\n  \"stages\": [";
+
+        for (size_t stage = 0; stage < stages.size(); ++stage)
+        {
+            detail::stage_accumulator const & acc = stages[stage];
+            double const seconds = acc.ticks / rate;
+            stream << (stage == 0 ? "\n" : ",\n") << "    {\"name\": \"" << escaped(stage_names[stage])
+                   << "\", \"calls\": " << acc.calls << ", \"seconds\": " << seconds << ", \"items\": " << acc.items
+                   << ", \"items_per_second\": " << (seconds > 0 ? acc.items / seconds : 0.0)
+                   << ", \"min_ticks\": " << (acc.calls ? acc.min_ticks : 0)
+                   << ", \"median_ticks\": " << quantile(acc, 0.5) << ", \"p99_ticks\": " << quantile(acc, 0.99)
+                   << ", \"max_ticks\": " << acc.max_ticks << ", \"histogram\": [";
+
+            bool first{true};
+            for (size_t bucket = 0; bucket < acc.histogram.size(); ++bucket)
+            {
+                if (acc.histogram[bucket] == 0)
+                    continue;
+                stream << (first ? "" : ", ") << '[' << upper_bound(bucket) << ", " << acc.histogram[bucket] << ']';
+                first = false;
+            }
+            stream << "]}";
+        }
+        stream << "\n  ]\n}\n";
+    }
+
+    /*!\brief Writes the traced calls in the Chrome trace event format, one complete event per call with the thread
+     *        number as `tid`.
+     */
+    void write_chrome_trace(std::ostream & stream)
+    {
+        std::lock_guard lock{mutex};
+        double const ticks_per_microsecond = ticks_per_second() / 1e6;
+        uint64_t dropped{};
+        bool first{true};
+
+        stream << "{\"traceEvents\": [";
+        for_each_profile([&] (detail::thread_profile const & profile)
+        {
+            dropped += profile.dropped_events;
+            for (detail::trace_event const & event : profile.events)
+            {
+                stream << (first ? "\n" : ",\n") << "{\"name\": \"" << escaped(stage_names[event.stage])
+                       << "\", \"ph\": \"X\", \"pid\": 0, \"tid\": " << profile.thread
+                       << ", \"ts\": " << (event.begin - start_cycles) / ticks_per_microsecond
+                       << ", \"dur\": " << (event.end - event.begin) / ticks_per_microsecond << '}';
+                first = false;
+            }
+        });
+        stream << "\n], \"displayTimeUnit\": \"ms\", \"otherData\": {\"dropped_events\": " << dropped << "}}\n";
+    }
+
+private:
+    //!\brief The accumulators of the calling thread, merged into the profiler when the thread ends.
+    struct local_profile
+    {
+        //!\brief The accumulators.
+        detail::thread_profile profile{};
+
+        //!\brief Registers the accumulators.
+        local_profile()
+        {
+            profiler & owner = global();
+            std::lock_guard lock{owner.mutex};
+            profile.thread = owner.thread_count++;
+            owner.running.push_back(&profile);
+        }
+
+        //!\brief Moves the accumulators to the profiler.
+        ~local_profile()
+        {
+            profiler & owner = global();
+            std::lock_guard lock{owner.mutex};
+            std::erase(owner.running, &profile);
+            owner.finished.push_back(std::move(profile));
+        }
+    };
+
+    //!\brief Protects everything but the accumulators of running threads.
+    std::mutex mutex{};
+    //!\brief Whether calls are recorded.
+    std::atomic<bool> active{false};
+    //!\brief Whether calls are traced.
+    std::atomic<bool> tracing{false};
+    //!\brief The names of the stages by id.
+    std::vector<std::string> stage_names{};
+    //!\brief The accumulators of the running threads.
+    std::vector<detail::thread_profile *> running{};
+    //!\brief The accumulators of the threads that ended.
+    std::vector<detail::thread_profile> finished{};
+    //!\brief The number of threads that recorded.
+    uint32_t thread_count{};
+    //!\brief The counter at enable().
+    uint64_t start_cycles{detail::read_cycles()};
+    //!\brief The time at enable().
+    std::chrono::steady_clock::time_point start_time{std::chrono::steady_clock::now()};
+
+    //!\brief The accumulators of the calling thread.
+    static local_profile & local()
+    {
+        thread_local local_profile profile{};
+        return profile;
+    }
+
+    //!\brief Calls `function` with the accumulators of every thread.
+    template <typename function_t>
+    void for_each_profile(function_t && function) const
+    {
+        for (detail::thread_profile const & profile : finished)
+            function(profile);
+        for (detail::thread_profile const * profile : running)
+            function(*profile);
+    }
+
+    //!\brief The seconds since enable().
+    double wall_seconds() const
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    }
+
+    //!\brief The rate of detail::read_cycles() since enable().
+    double ticks_per_second() const
+    {
+        double const seconds = wall_seconds();
+        return seconds > 0 ? (detail::read_cycles() - start_cycles) / seconds : 1e9;
+    }
+
+    //!\brief The largest number of ticks in a bucket of the histogram.
+    static uint64_t upper_bound(size_t const bucket) noexcept
+    {
+        return bucket >= 64 ? std::numeric_limits<uint64_t>::max() : (uint64_t{1} << bucket) - 1;
+    }
+
+    //!\brief The upper bound of the bucket containing the quantile `q` of the calls.
+    static uint64_t quantile(detail::stage_accumulator const & acc, double const q) noexcept
+    {
+        uint64_t const rank = static_cast<uint64_t>(q * acc.calls);
+        uint64_t seen{};
+        for (size_t bucket = 0; bucket < acc.histogram.size(); ++bucket)
+        {
+            seen += acc.histogram[bucket];
+            if (seen > rank)
+                return std::min(upper_bound(bucket), acc.max_ticks);
+        }
+        return acc.max_ticks;
+    }
+
+    //!\brief Escapes quotes and backslashes of a stage name for JSON.
+    static std::string escaped(std::string_view const name)
+    {
+        std::string result{};
+        for (char const c : name)
+        {
+            if (c == '"' || c == '\\')
+                result.push_back('\\');
+            result.push_back(c);
+        }
+        return result;
+    }
+};
+
+/*!\brief Records the time from construction to destruction as a call of a stage of seqan3::profiler::global().
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * ```cpp
+ * static size_t const stage = seqan3::profiler::global().stage("sample");
+ * {
+ *     seqan3::scoped_timer timer{stage, sequence.size()};
+ *     for (uint64_t hash : sequence | syncmer_hash(11, 15))
+ *         hashes.push_back(hash);
+ * }
+ * ```
+ *
+ * If the profiler is not enabled at construction, nothing is recorded.
+ */
+class scoped_timer
+{
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    scoped_timer() = delete; //!< Deleted.
+    scoped_timer(scoped_timer const &) = delete; //!< Deleted.
+    scoped_timer(scoped_timer &&) = delete; //!< Deleted.
+    scoped_timer & operator=(scoped_timer const &) = delete; //!< Deleted.
+    scoped_timer & operator=(scoped_timer &&) = delete; //!< Deleted.
+
+    //!\brief Starts a call of `stage` that processes `items` items.
+    explicit scoped_timer(size_t const stage, uint64_t const items = 0) noexcept :
+        stage{stage},
+        items{items},
+        active{profiler::global().enabled()},
+        begin{active ? detail::read_cycles() : 0}
+    {}
+
+    //!\brief Records the call.
+    ~scoped_timer()
+    {
+        if (active)
+            profiler::global().record(stage, begin, detail::read_cycles(), items);
+    }
+    //!\}
+
+    //!\brief Adds items to the call, e.g. when they are only known at the end.
+    void add_items(uint64_t const count) noexcept
+    {
+        items += count;
+    }
+
+private:
+    //!\brief The stage.
+    size_t stage{};
+    //!\brief The items of the call.
+    uint64_t items{};
+    //!\brief Whether the profiler was enabled at construction.
+    bool active{};
+    //!\brief The counter at construction.
+    uint64_t begin{};
+};
+} // namespace seqan3
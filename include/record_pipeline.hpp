@@ -0,0 +1,650 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Hossein Eizadi Moghadam <hosseinem AT fu-berlin.de>
+ * \brief Provides seqan3::record_pipeline.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <semaphore>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <zlib.h>
+
+#include <seqan3/io/exception.hpp>
+#include "mapped_sequence_file.hpp"
+
+namespace seqan3
+{
+namespace detail
+{
+/*!\brief A queue with a fixed capacity; push() blocks while it is full and pop() while it is empty.
+ * \details After close(), push() fails and pop() returns the remaining values, then std::nullopt.
+ */
+template <typename value_t>
+class bounded_queue
+{
+public:
+    //!\brief Construct with a capacity.
+    explicit bounded_queue(size_t const capacity) : capacity{capacity}
+    {}
+
+    //!\brief Appends a value; returns false if the queue is closed.
+    bool push(value_t value)
+    {
+        std::unique_lock lock{mutex};
+        not_full.wait(lock, [this] () { return closed || values.size() < capacity; });
+        if (closed)
+            return false;
+        values.push(std::move(value));
+        not_empty.notify_one();
+        return true;
+    }
+
+    //!\brief Removes the first value; std::nullopt if the queue is closed and empty.
+    std::optional<value_t> pop()
+    {
+        std::unique_lock lock{mutex};
+        not_empty.wait(lock, [this] () { return closed || !values.empty(); });
+        if (values.empty())
+            return std::nullopt;
+        value_t value{std::move(values.front())};
+        values.pop();
+        not_full.notify_one();
+        return value;
+    }
+
+    //!\brief Wakes all waiting threads; no values can be pushed afterwards.
+    void close()
+    {
+        std::lock_guard lock{mutex};
+        closed = true;
+        not_empty.notify_all();
+        not_full.notify_all();
+    }
+
+private:
+    //!\brief The maximal number of values.
+    size_t capacity{};
+    //!\brief The values.
+    std::queue<value_t> values{};
+    //!\brief Whether close() was called.
+    bool closed{false};
+    //!\brief Guards all members.
+    std::mutex mutex{};
+    //!\brief Signalled when a value was pushed or the queue was closed.
+    std::condition_variable not_empty{};
+    //!\brief Signalled when a value was popped or the queue was closed.
+    std::condition_variable not_full{};
+};
+} // namespace detail
+
+/*!\brief Reads a FASTA or FASTQ file, optionally gzip or BGZF compressed, in a pipeline of threads and calls a function
+ *        with every record.
+ * \tparam alphabet_t The alphabet of the sequences. Default: seqan3::dna4.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * run() connects three stages, so that the threads calling the function, e.g. to run syncmer_hash, never wait for
+ * decompression as long as it keeps up:
+ *
+ * 1. Decompression fills a ring of `buffer_count` buffers of about `buffer_size` bytes. A gzip file is inflated by one
+ *    thread. A BGZF file, e.g. written by bgzip, consists of independent blocks of at most 64 KiB; one thread reads
+ *    the compressed blocks and `decompression_threads` threads inflate one buffer of blocks each. Uncompressed files
+ *    are read as they are.
+ * 2. One thread splits the buffers, in file order, at record boundaries. The records within a buffer are passed on
+ *    without copying; only a record that spans two buffers is copied.
+ * 3. `threads` threads parse the records and call the function with a seqan3::mapped_record and their thread index
+ *    in `[0, threads)`. Records are passed in file order per buffer, but the buffers are processed concurrently.
+ *
+ * A buffer is reused once all of its records have been processed, so the memory is bounded by the ring. Records are
+ * split like by seqan3::mapped_sequence_file, except that FASTQ records must have four lines, as written by all
+ * sequencers; FASTA records may span several lines. Using this header requires linking zlib.
+ */
+template <semialphabet alphabet_t = dna4>
+class record_pipeline
+{
+public:
+    //!\brief The type of the records passed to the function.
+    using record_type = mapped_record<alphabet_t>;
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    record_pipeline() = delete; //!< Deleted.
+    record_pipeline(record_pipeline const &) = delete; //!< Deleted.
+    record_pipeline(record_pipeline &&) = default; //!< Defaulted.
+    record_pipeline & operator=(record_pipeline const &) = delete; //!< Deleted.
+    record_pipeline & operator=(record_pipeline &&) = default; //!< Defaulted.
+    ~record_pipeline() = default; //!< Defaulted.
+
+    /*!\brief Construct from a file and the sizes of the stages.
+     * \param[in] path                  The FASTA or FASTQ file, uncompressed, gzip or BGZF.
+     * \param[in] threads               The number of threads calling the function. Default: 1.
+     * \param[in] decompression_threads The number of threads inflating BGZF blocks. Default: 1.
+     * \param[in] buffer_count          The number of buffers in the ring. Default: 8.
+     * \param[in] buffer_size           The number of decompressed bytes per buffer. Default: 4 MiB.
+     * \throws std::invalid_argument if a parameter is 0 or `buffer_size` is smaller than a BGZF block (64 KiB).
+     */
+    explicit record_pipeline(std::filesystem::path path,
+                             size_t const threads = 1,
+                             size_t const decompression_threads = 1,
+                             size_t const buffer_count = 8,
+                             size_t const buffer_size = 1u << 22) :
+        path{std::move(path)},
+        threads{threads},
+        decompression_threads{decompression_threads},
+        buffer_count{buffer_count},
+        buffer_size{buffer_size}
+    {
+        if (threads == 0 || decompression_threads == 0)
+            throw std::invalid_argument{"The chosen number of threads is not valid. Please choose a value greater than 0."};
+
+        if (buffer_count == 0)
+            throw std::invalid_argument{"The chosen buffer_count is not valid. Please choose a value greater than 0."};
+
+        if (buffer_size < max_block_size)
+            throw std::invalid_argument{"The chosen buffer_size is not valid. Please choose at least 64 KiB."};
+    }
+    //!\}
+
+    /*!\brief Calls `callback(record, thread)` with every record of the file.
+     * \param[in] callback Called concurrently from `threads` threads with a `record_type const &`, which is only valid
+     *                     during the call, and the index of the calling thread.
+     * \throws seqan3::file_open_error if the file cannot be opened.
+     * \throws seqan3::format_error if the file is not a valid (compressed) FASTA or FASTQ file.
+     *
+     * \details If the callback or a stage throws, the pipeline stops and the first exception is rethrown.
+     */
+    template <typename callback_t>
+    void run(callback_t && callback)
+    {
+        std::FILE * const file = std::fopen(path.c_str(), "rb");
+        if (file == nullptr)
+            throw file_open_error{"Could not open the file " + path.string() + "."};
+
+        bool const bgzf = is_bgzf(file);
+        std::fclose(file);
+
+        state shared{buffer_count, threads};
+
+        {
+            std::vector<std::jthread> workers{};
+
+            if (bgzf)
+            {
+                workers.emplace_back([&] () { guarded(shared, [&] () { read_bgzf(shared); }); });
+                for (size_t thread = 0; thread < decompression_threads; ++thread)
+                    workers.emplace_back([&] () { guarded(shared, [&] () { inflate_bgzf(shared); }); });
+            }
+            else
+            {
+                workers.emplace_back([&] () { guarded(shared, [&] () { inflate_gzip(shared); }); });
+            }
+
+            workers.emplace_back([&] () { guarded(shared, [&] () { split(shared); }); });
+
+            for (size_t thread = 0; thread < threads; ++thread)
+                workers.emplace_back([&, thread] () { guarded(shared, [&] () { parse(shared, callback, thread); }); });
+        }
+
+        if (shared.error)
+            std::rethrow_exception(shared.error);
+    }
+
+    /*!\brief Whether a file is gzip or BGZF compressed, i.e. starts with the gzip magic bytes.
+     * \param[in] path The file.
+     * \throws seqan3::file_open_error if the file cannot be opened.
+     * \details Lets a tool read uncompressed files with seqan3::mapped_sequence_file and only use the pipeline for
+     *          compressed ones.
+     */
+    static bool is_compressed(std::filesystem::path const & path)
+    {
+        std::FILE * const file = std::fopen(path.c_str(), "rb");
+        if (file == nullptr)
+            throw file_open_error{"Could not open the file " + path.string() + "."};
+
+        unsigned char magic[2]{};
+        bool const compressed = std::fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+                                magic[0] == 0x1f && magic[1] == 0x8b;
+        std::fclose(file);
+        return compressed;
+    }
+
+private:
+    //!\brief The largest decompressed or compressed size of a BGZF block.
+    static constexpr size_t max_block_size{1u << 16};
+
+    //!\brief A buffer of the ring; returned to the ring when the last reference is gone.
+    using buffer_t = std::shared_ptr<std::vector<char> const>;
+
+    //!\brief A numbered buffer of compressed BGZF blocks.
+    struct compressed_chunk
+    {
+        size_t number{};
+        std::vector<char> blocks{};
+    };
+
+    //!\brief A part of a buffer that only contains complete records.
+    struct batch
+    {
+        buffer_t buffer{};
+        std::string_view records{};
+    };
+
+    //!\brief The queues and the error of one run.
+    struct state
+    {
+        //!\brief Construct the queues of a ring of `buffer_count` buffers and `threads` parsing threads.
+        state(size_t const buffer_count, size_t const threads) :
+            free_buffers{static_cast<std::ptrdiff_t>(buffer_count)},
+            compressed{buffer_count},
+            batches{2 * threads + 2}
+        {}
+
+        //!\brief The number of buffers that can still be filled.
+        std::counting_semaphore<> free_buffers;
+        //!\brief Reused buffer storage.
+        std::vector<std::unique_ptr<std::vector<char>>> storage{};
+        //!\brief Guards storage and decompressed.
+        std::mutex mutex{};
+        //!\brief Signalled when a buffer was decompressed.
+        std::condition_variable decompressed_ready{};
+        //!\brief The decompressed buffers by number, until they are split.
+        std::map<size_t, buffer_t> decompressed{};
+        //!\brief The number of buffers, known once the input is exhausted.
+        std::optional<size_t> buffer_total{};
+        //!\brief The compressed BGZF chunks.
+        detail::bounded_queue<compressed_chunk> compressed;
+        //!\brief The batches of complete records.
+        detail::bounded_queue<batch> batches;
+        //!\brief Set when a stage fails; all stages stop.
+        std::atomic<bool> failed{false};
+        //!\brief The first exception of a stage.
+        std::exception_ptr error{};
+    };
+
+    //!\brief The file.
+    std::filesystem::path path{};
+    //!\brief The number of threads calling the function.
+    size_t threads{};
+    //!\brief The number of threads inflating BGZF blocks.
+    size_t decompression_threads{};
+    //!\brief The number of buffers in the ring.
+    size_t buffer_count{};
+    //!\brief The number of decompressed bytes per buffer.
+    size_t buffer_size{};
+
+    //!\brief Whether the file starts with a BGZF block header, i.e. a gzip header with a 'BC' extra field.
+    static bool is_bgzf(std::FILE * const file)
+    {
+        unsigned char header[18]{};
+        return std::fread(header, 1, sizeof(header), file) == sizeof(header) &&
+               header[0] == 0x1f && header[1] == 0x8b && header[2] == 8 && (header[3] & 4) &&
+               header[10] == 6 && header[11] == 0 && header[12] == 'B' && header[13] == 'C';
+    }
+
+    //!\brief Runs a stage; records its exception and stops all stages if it throws.
+    template <typename stage_t>
+    static void guarded(state & shared, stage_t && stage) noexcept
+    {
+        try
+        {
+            stage();
+        }
+        catch (...)
+        {
+            std::lock_guard lock{shared.mutex};
+            if (!shared.error)
+                shared.error = std::current_exception();
+            shared.failed = true;
+            shared.decompressed_ready.notify_all();
+            shared.compressed.close();
+            shared.batches.close();
+        }
+    }
+
+    /*!\brief Reserves a buffer of the ring, waiting until one is free.
+     * \returns False, if the pipeline failed while waiting.
+     * \details Buffers are reserved in file order, so that the buffer the splitting stage waits for always has one.
+     */
+    static bool reserve(state & shared)
+    {
+        using namespace std::chrono_literals;
+        while (!shared.free_buffers.try_acquire_for(10ms))
+            if (shared.failed)
+                return false;
+        return !shared.failed;
+    }
+
+    //!\brief The empty storage of a reserved buffer.
+    static std::unique_ptr<std::vector<char>> storage_of_reserved(state & shared)
+    {
+        std::lock_guard lock{shared.mutex};
+        if (shared.storage.empty())
+            return std::make_unique<std::vector<char>>();
+        std::unique_ptr<std::vector<char>> buffer = std::move(shared.storage.back());
+        shared.storage.pop_back();
+        buffer->clear();
+        return buffer;
+    }
+
+    //!\brief Turns a filled buffer into a shared buffer that returns itself to the ring when released.
+    static buffer_t share(state & shared, std::unique_ptr<std::vector<char>> buffer)
+    {
+        return buffer_t{buffer.release(), [&shared] (std::vector<char> const * released)
+        {
+            {
+                std::lock_guard lock{shared.mutex};
+                shared.storage.emplace_back(const_cast<std::vector<char> *>(released));
+            }
+            shared.free_buffers.release();
+        }};
+    }
+
+    //!\brief Hands a decompressed buffer to the splitting stage.
+    static void publish(state & shared, size_t const number, buffer_t buffer)
+    {
+        std::lock_guard lock{shared.mutex};
+        shared.decompressed.emplace(number, std::move(buffer));
+        shared.decompressed_ready.notify_all();
+    }
+
+    //!\brief Marks the end of the input after `total` buffers.
+    static void finish(state & shared, size_t const total)
+    {
+        std::lock_guard lock{shared.mutex};
+        shared.buffer_total = total;
+        shared.decompressed_ready.notify_all();
+    }
+
+    //!\brief Stage 1 for gzip or uncompressed files: inflates the file into the buffers of the ring.
+    void inflate_gzip(state & shared)
+    {
+        gzFile file = gzopen(path.c_str(), "rb");
+        if (file == nullptr)
+            throw file_open_error{"Could not open the file " + path.string() + "."};
+        std::unique_ptr<gzFile_s, decltype(&gzclose)> const guard{file, &gzclose};
+        gzbuffer(file, 1u << 17);
+
+        size_t number{0};
+        while (reserve(shared))
+        {
+            std::unique_ptr<std::vector<char>> buffer = storage_of_reserved(shared);
+            buffer->resize(buffer_size);
+
+            int const read = gzread(file, buffer->data(), static_cast<unsigned>(buffer_size));
+            int error{Z_OK};
+            gzerror(file, &error);
+            // A truncated file ends without an error of gzread(), but sets Z_BUF_ERROR.
+            if (read < 0 || (error != Z_OK && error != Z_STREAM_END))
+                throw format_error{"The file " + path.string() + " is not a valid gzip file."};
+
+            buffer->resize(read);
+            if (read == 0)
+            {
+                shared.free_buffers.release();
+                break;
+            }
+
+            publish(shared, number++, share(shared, std::move(buffer)));
+        }
+
+        finish(shared, number);
+    }
+
+    //!\brief Stage 1 for BGZF files: reads the compressed blocks and groups them into chunks of at most `buffer_size`
+    //!       decompressed bytes.
+    void read_bgzf(state & shared)
+    {
+        std::FILE * const file = std::fopen(path.c_str(), "rb");
+        if (file == nullptr)
+            throw file_open_error{"Could not open the file " + path.string() + "."};
+        std::unique_ptr<std::FILE, decltype(&std::fclose)> const guard{file, &std::fclose};
+
+        compressed_chunk chunk{};
+        size_t decompressed_size{0};
+        unsigned char header[18]{};
+
+        while (!shared.failed && std::fread(header, 1, sizeof(header), file) == sizeof(header))
+        {
+            if (header[0] != 0x1f || header[1] != 0x8b || header[12] != 'B' || header[13] != 'C')
+                throw format_error{"The file " + path.string() + " contains a block that is not BGZF."};
+
+            size_t const block_size = (header[16] | header[17] << 8) + 1u;
+            size_t const start = chunk.blocks.size();
+            chunk.blocks.resize(start + block_size);
+            std::memcpy(chunk.blocks.data() + start, header, sizeof(header));
+            if (std::fread(chunk.blocks.data() + start + sizeof(header), 1, block_size - sizeof(header), file) !=
+                block_size - sizeof(header))
+                throw format_error{"The file " + path.string() + " ends inside a BGZF block."};
+
+            unsigned char const * const end = reinterpret_cast<unsigned char const *>(chunk.blocks.data()) + start
+                                            + block_size;
+            decompressed_size += end[-4] | end[-3] << 8 | end[-2] << 16 | static_cast<size_t>(end[-1]) << 24;
+
+            if (decompressed_size + max_block_size > buffer_size)
+            {
+                size_t const number = chunk.number;
+                if (!reserve(shared))
+                    break;
+                shared.compressed.push(std::move(chunk));
+                chunk = compressed_chunk{number + 1};
+                decompressed_size = 0;
+            }
+        }
+
+        size_t total = chunk.number;
+        if (!chunk.blocks.empty() && reserve(shared))
+        {
+            shared.compressed.push(std::move(chunk));
+            ++total;
+        }
+
+        shared.compressed.close();
+        finish(shared, total);
+    }
+
+    //!\brief Stage 1 for BGZF files: inflates the compressed chunks into the buffers of the ring.
+    void inflate_bgzf(state & shared)
+    {
+        z_stream stream{};
+        if (inflateInit2(&stream, 15 + 16) != Z_OK)
+            throw format_error{"Could not initialise zlib."};
+        std::unique_ptr<z_stream, decltype(&inflateEnd)> const guard{&stream, &inflateEnd};
+
+        while (std::optional<compressed_chunk> chunk = shared.compressed.pop())
+        {
+            std::unique_ptr<std::vector<char>> buffer = storage_of_reserved(shared);
+            buffer->resize(buffer_size);
+
+            stream.next_in = reinterpret_cast<Bytef *>(chunk->blocks.data());
+            stream.avail_in = static_cast<uInt>(chunk->blocks.size());
+            stream.next_out = reinterpret_cast<Bytef *>(buffer->data());
+            stream.avail_out = static_cast<uInt>(buffer->size());
+
+            // Every block is a gzip member; inflate stops at the end of each and is reset for the next.
+            while (stream.avail_in != 0)
+            {
+                int const status = inflate(&stream, Z_NO_FLUSH);
+                if (status == Z_STREAM_END)
+                    inflateReset(&stream);
+                else if (status != Z_OK)
+                    throw format_error{"The file " + path.string() + " contains a corrupt BGZF block."};
+            }
+
+            buffer->resize(buffer->size() - stream.avail_out);
+            inflateReset(&stream);
+            publish(shared, chunk->number, share(shared, std::move(buffer)));
+        }
+    }
+
+    //!\brief The positions of `text` after which only complete records precede, given the `line_count` lines
+    //!       before `text` since the last such position.
+    struct boundaries
+    {
+        //!\brief The first boundary, std::string_view::npos if there is none.
+        size_t first{std::string_view::npos};
+        //!\brief The last boundary.
+        size_t last{std::string_view::npos};
+        //!\brief The lines after the last boundary, or after the preceding lines if there is no boundary.
+        size_t line_count{};
+    };
+
+    //!\brief FASTA records start with a '>' at the start of a line; `line_start` says whether `text` starts a line.
+    static boundaries fasta_boundaries(std::string_view const text, bool const line_start) noexcept
+    {
+        boundaries found{};
+        for (size_t position = text.find('>'); position != std::string_view::npos; position = text.find('>', position + 1))
+        {
+            if (position == 0 ? line_start : text[position - 1] == '\n')
+            {
+                found.first = position;
+                break;
+            }
+        }
+
+        for (size_t position = text.rfind('>'); position != std::string_view::npos && position >= found.first;
+             position = position == 0 ? std::string_view::npos : text.rfind('>', position - 1))
+        {
+            if (position == 0 ? line_start : text[position - 1] == '\n')
+            {
+                found.last = position;
+                break;
+            }
+        }
+
+        return found;
+    }
+
+    //!\brief FASTQ records have four lines; `line_count` is the number of complete lines before `text` since the
+    //!       last boundary, `record_start` says whether `text` starts a record.
+    static boundaries fastq_boundaries(std::string_view const text, size_t line_count, bool const record_start) noexcept
+    {
+        boundaries found{};
+        if (record_start)
+            found.first = found.last = 0;
+
+        char const * const first = text.data();
+        char const * const last = first + text.size();
+        for (char const * line_end = static_cast<char const *>(std::memchr(first, '\n', text.size()));
+             line_end != nullptr;
+             line_end = static_cast<char const *>(std::memchr(line_end + 1, '\n', last - line_end - 1)))
+        {
+            if (++line_count == 4)
+            {
+                line_count = 0;
+                found.last = line_end + 1 - first;
+                if (found.first == std::string_view::npos)
+                    found.first = found.last;
+            }
+        }
+
+        found.line_count = line_count;
+        return found;
+    }
+
+    //!\brief Stage 2: splits the decompressed buffers in file order into batches of complete records.
+    void split(state & shared)
+    {
+        std::string carry{}; // The beginning of the record that spans the previous buffers.
+        size_t carry_lines{0};
+        bool fastq{false};
+
+        for (size_t number = 0; ; ++number)
+        {
+            buffer_t buffer{};
+            {
+                std::unique_lock lock{shared.mutex};
+                shared.decompressed_ready.wait(lock, [&] ()
+                {
+                    return shared.failed || shared.decompressed.contains(number) ||
+                           (shared.buffer_total && *shared.buffer_total == number);
+                });
+
+                if (shared.failed || !shared.decompressed.contains(number))
+                    break;
+
+                buffer = std::move(shared.decompressed.at(number));
+                shared.decompressed.erase(number);
+            }
+
+            std::string_view const text{buffer->data(), buffer->size()};
+            if (number == 0)
+            {
+                size_t const start = text.find_first_not_of("\r\n");
+                fastq = start != std::string_view::npos && text[start] == '@';
+            }
+
+            boundaries const found = fastq ? fastq_boundaries(text, carry_lines, carry.empty())
+                                           : fasta_boundaries(text, carry.empty() || carry.back() == '\n');
+
+            if (found.first == std::string_view::npos)
+            {
+                carry.append(text);
+                carry_lines = found.line_count;
+                continue;
+            }
+
+            if (!carry.empty() || found.first != 0)
+            {
+                carry.append(text.substr(0, found.first));
+                auto const stitched = std::make_shared<std::vector<char> const>(carry.begin(), carry.end());
+                shared.batches.push({stitched, std::string_view{stitched->data(), stitched->size()}});
+            }
+
+            carry.assign(text.substr(found.last));
+            carry_lines = found.line_count;
+
+            if (found.last != found.first)
+                shared.batches.push({std::move(buffer), text.substr(found.first, found.last - found.first)});
+        }
+
+        if (!carry.empty())
+        {
+            auto const stitched = std::make_shared<std::vector<char> const>(carry.begin(), carry.end());
+            shared.batches.push({stitched, std::string_view{stitched->data(), stitched->size()}});
+        }
+
+        shared.batches.close();
+    }
+
+    //!\brief Stage 3: parses the batches and calls the function with every record.
+    template <typename callback_t>
+    static void parse(state & shared, callback_t & callback, size_t const thread)
+    {
+        using iterator = typename mapped_sequence_file<alphabet_t>::iterator;
+
+        while (std::optional<batch> const current = shared.batches.pop())
+        {
+            if (shared.failed)
+                continue;
+
+            char const * const first = current->records.data();
+            for (iterator it{first, first + current->records.size()}; it != std::default_sentinel; ++it)
+                callback(*it, thread);
+        }
+    }
+};
+} // namespace seqan3
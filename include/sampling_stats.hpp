@@ -0,0 +1,123 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Hossein Eizadi Moghadam <hosseinem AT fu-berlin.de>
+ * \brief Provides seqan3::sampling_stats.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/*!\brief Whether the iterators of the sampling views count their work, see seqan3::sampling_stats.
+ * \details Define as 1 before including the views; when 0 the counters are empty and the iterators are unchanged.
+ */
+#ifndef SEQAN3_SAMPLING_STATS
+#define SEQAN3_SAMPLING_STATS 0
+#endif
+
+namespace seqan3
+{
+/*!\brief The work of an iterator of syncmer_view, opensyncmer_view, minimiser_view or minstrobe_view.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * The views only search the whole window again when the smallest value leaves it, so the cost per position is
+ * `scanned / positions`. It grows with the number of rescans, which is large on low-complexity sequence, e.g. repeats
+ * with many equal values in a window; `ties` counts new values equal to the current smallest value, which decide
+ * where the smallest value is tracked. The counters are only maintained if SEQAN3_SAMPLING_STATS is 1, otherwise all
+ * are 0.
+ */
+struct sampling_stats
+{
+    //!\brief The number of windows processed.
+    uint64_t positions{};
+    //!\brief The number of searches of a whole window for its smallest value, including the first window.
+    uint64_t rescans{};
+    //!\brief The number of values compared by the rescans.
+    uint64_t scanned{};
+    //!\brief The number of values returned by the iterator.
+    uint64_t samples{};
+    //!\brief The number of new values equal to the smallest value of the window.
+    uint64_t ties{};
+
+    //!\brief Adds the counters of another iterator, e.g. of another sequence.
+    sampling_stats & operator+=(sampling_stats const & other) noexcept
+    {
+        positions += other.positions;
+        rescans += other.rescans;
+        scanned += other.scanned;
+        samples += other.samples;
+        ties += other.ties;
+        return *this;
+    }
+
+    //!\brief Compares all counters.
+    bool operator==(sampling_stats const &) const = default;
+};
+
+namespace detail
+{
+//!\brief The counters of seqan3::sampling_stats kept by the iterators of the sampling views.
+template <bool enabled = SEQAN3_SAMPLING_STATS>
+struct sampling_counters
+{
+    //!\brief The counters.
+    sampling_stats values{};
+
+    //!\brief Counts a window.
+    void position() noexcept
+    {
+        ++values.positions;
+    }
+
+    //!\brief Counts a search of `elements` values.
+    void rescan(size_t const elements) noexcept
+    {
+        ++values.rescans;
+        values.scanned += elements;
+    }
+
+    //!\brief Counts a returned value.
+    void sample() noexcept
+    {
+        ++values.samples;
+    }
+
+    //!\brief Counts a new value if it equals the smallest value.
+    void tie(bool const is_tie) noexcept
+    {
+        values.ties += is_tie;
+    }
+
+    //!\brief Returns the counters.
+    sampling_stats stats() const noexcept
+    {
+        return values;
+    }
+};
+
+//!\brief The disabled counters; empty, so that `[[no_unique_address]]` members take no space.
+template <>
+struct sampling_counters<false>
+{
+    void position() noexcept {} //!< Does nothing.
+    void rescan(size_t) noexcept {} //!< Does nothing.
+    void sample() noexcept {} //!< Does nothing.
+    void tie(bool) noexcept {} //!< Does nothing.
+
+    //!\brief Returns zeros.
+    sampling_stats stats() const noexcept
+    {
+        return {};
+    }
+};
+} // namespace detail
+} // namespace seqan3
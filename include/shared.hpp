@@ -1,5 +1,8 @@
 #pragma once
 
+#include <charconv>
+#include <cstdint>
+
 //
 /*! \brief Function that ensures random hashes, based on https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function
  *  \param hash_value The hash_value that should be transformed.
@@ -14,16 +17,44 @@ uint64_t fnv_hash(uint64_t hash_value, uint64_t seed)
     constexpr static uint64_t default_offset_basis = 0xcbf29ce484222325;
     constexpr static uint64_t prime                = 0x100000001b3;
 
+    // The decimal digits of the hash value, formatted on the stack instead of in a std::ostringstream.
     uint64_t hashed = hash_value;
-    std::ostringstream os;
-    os << hash_value;
-    std::string oss = os.str();
+    char digits[20];
+    char const * const digits_end = std::to_chars(digits, digits + sizeof(digits), hash_value).ptr;
 
-    for (int i = 0; i < oss.size(); i++)
+    for (char const * digit = digits; digit != digits_end; ++digit)
     {
         hashed = hashed * prime;
-        hashed= hashed ^ oss[i];
+        hashed= hashed ^ *digit;
     }
 
     return hashed;
 }
+
+/*! \brief Bijective 64 bit finaliser of MurmurHash3, spreads the bits of a k-mer hash over the whole 64 bit range.
+ *  \param hash_value The hash_value that should be mixed.
+ *  \details Raw k-mer hashes only use the lowest 2k bits and are ordered lexicographically, sampling schemes that
+ *           compare against a threshold or a modulus need uniformly distributed values instead.
+ */
+inline constexpr uint64_t mix_hash(uint64_t hash_value) noexcept
+{
+    hash_value ^= hash_value >> 33;
+    hash_value *= 0xff51afd7ed558ccdULL;
+    hash_value ^= hash_value >> 33;
+    hash_value *= 0xc4ceb9fe1a85ec53ULL;
+    hash_value ^= hash_value >> 33;
+    return hash_value;
+}
+
+/*! \brief Inverse of mix_hash, `unmix_hash(mix_hash(x)) == x`.
+ *  \param hash_value The mixed hash_value that should be restored.
+ */
+inline constexpr uint64_t unmix_hash(uint64_t hash_value) noexcept
+{
+    hash_value ^= hash_value >> 33;
+    hash_value *= 0x9cb4b2f8129337dbULL;
+    hash_value ^= hash_value >> 33;
+    hash_value *= 0x4f74430c22a54005ULL;
+    hash_value ^= hash_value >> 33;
+    return hash_value;
+}
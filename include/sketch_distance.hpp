@@ -0,0 +1,201 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Hossein Eizadi Moghadam <hosseinem AT fu-berlin.de>
+ * \brief Provides seqan3::intersection_count and the sketch distances built on it.
+ */
+
+#pragma once
+
+#include <seqan3/std/algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define SEQAN3_SKETCH_DISTANCE_AVX2 1
+#endif
+
+namespace seqan3
+{
+namespace detail
+{
+//!\brief Counts the common values of two sorted ranges without branching on the comparison.
+inline size_t merge_intersection_count(std::span<uint64_t const> a, std::span<uint64_t const> b) noexcept
+{
+    size_t count{0};
+    size_t i{0};
+    size_t j{0};
+    while (i < a.size() && j < b.size())
+    {
+        uint64_t const x = a[i];
+        uint64_t const y = b[j];
+        count += x == y;
+        i += x <= y;
+        j += y <= x;
+    }
+    return count;
+}
+
+/*!\brief Counts the common values of a short and a long sorted range by exponential search in the long one.
+ * \details Takes O(|small| log(|large| / |small|)) steps instead of O(|small| + |large|) of a merge.
+ */
+inline size_t galloping_intersection_count(std::span<uint64_t const> small, std::span<uint64_t const> large) noexcept
+{
+    size_t count{0};
+    size_t start{0};
+    for (uint64_t const value : small)
+    {
+        // Find a bound with large[start + step] >= value, then search the last interval.
+        size_t step{1};
+        while (start + step < large.size() && large[start + step] < value)
+            step <<= 1;
+
+        auto const first = large.begin() + start;
+        auto const last = large.begin() + std::min(start + step + 1, large.size());
+        auto const found = std::lower_bound(first, last, value);
+
+        start = found - large.begin();
+        if (start == large.size())
+            break;
+        count += *found == value;
+    }
+    return count;
+}
+
+#if SEQAN3_SKETCH_DISTANCE_AVX2
+/*!\brief Counts the common values of two sorted ranges without duplicates, four values of each at a time.
+ * \details Every value of a block of `a` is compared with every value of a block of `b` by comparing the block of
+ *          `a` with the four rotations of the block of `b`; the block with the smaller last value is then replaced.
+ *          Because there are no duplicates, every value of `a` matches at most one value of `b`.
+ */
+__attribute__((target("avx2,popcnt")))
+inline size_t avx2_intersection_count(std::span<uint64_t const> a, std::span<uint64_t const> b) noexcept
+{
+    size_t count{0};
+    size_t i{0};
+    size_t j{0};
+
+    if (a.size() >= 4 && b.size() >= 4)
+    {
+        size_t const a_end = a.size() & ~size_t{3};
+        size_t const b_end = b.size() & ~size_t{3};
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(a.data()));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(b.data()));
+
+        while (true)
+        {
+            __m256i equal = _mm256_cmpeq_epi64(va, vb);
+            equal = _mm256_or_si256(equal, _mm256_cmpeq_epi64(va, _mm256_permute4x64_epi64(vb, 0b00'11'10'01)));
+            equal = _mm256_or_si256(equal, _mm256_cmpeq_epi64(va, _mm256_permute4x64_epi64(vb, 0b01'00'11'10)));
+            equal = _mm256_or_si256(equal, _mm256_cmpeq_epi64(va, _mm256_permute4x64_epi64(vb, 0b10'01'00'11)));
+            count += _mm_popcnt_u32(_mm256_movemask_pd(_mm256_castsi256_pd(equal)));
+
+            uint64_t const a_last = a[i + 3];
+            uint64_t const b_last = b[j + 3];
+            i += a_last <= b_last ? 4 : 0;
+            j += b_last <= a_last ? 4 : 0;
+            if (i == a_end || j == b_end)
+                break;
+
+            va = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(a.data() + i));
+            vb = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(b.data() + j));
+        }
+    }
+
+    // The block at the end of one range was never loaded, so no pair of the remaining values has been compared.
+    return count + merge_intersection_count(a.subspan(i), b.subspan(j));
+}
+
+//!\brief Whether the processor supports the AVX2 kernel; determined once.
+inline bool has_avx2() noexcept
+{
+    static bool const supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+    return supported;
+}
+#endif
+} // namespace detail
+
+/*!\brief Counts the common hashes of two sorted sketches, e.g. decoded from a seqan3::sketch_file.
+ * \param[in] a A sorted range of hashes without duplicates.
+ * \param[in] b A sorted range of hashes without duplicates.
+ * \returns The size of the intersection.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * If one sketch is more than 64 times larger, the larger one is searched for the values of the smaller one by
+ * exponential search. Otherwise, on x86-64 processors with AVX2 the sketches are merged four values at a time, else
+ * with a branch-free scalar merge. The AVX2 kernel is selected at runtime, so no compiler flags are needed.
+ */
+inline size_t intersection_count(std::span<uint64_t const> a, std::span<uint64_t const> b) noexcept
+{
+    if (a.size() > b.size())
+        std::swap(a, b);
+
+    if (a.empty())
+        return 0;
+
+    if (b.size() / a.size() > 64)
+        return detail::galloping_intersection_count(a, b);
+
+#if SEQAN3_SKETCH_DISTANCE_AVX2
+    if (detail::has_avx2())
+        return detail::avx2_intersection_count(a, b);
+#endif
+
+    return detail::merge_intersection_count(a, b);
+}
+
+/*!\brief The fraction of the hashes of `query` that are also in `reference`, 0 if `query` is empty.
+ * \ingroup search_views
+ */
+inline double containment(std::span<uint64_t const> query, std::span<uint64_t const> reference) noexcept
+{
+    return query.empty() ? 0.0 : static_cast<double>(intersection_count(query, reference)) / query.size();
+}
+
+/*!\brief The Jaccard index of two sketches, |a ∩ b| / |a ∪ b|; 0 if both are empty.
+ * \ingroup search_views
+ */
+inline double jaccard(std::span<uint64_t const> a, std::span<uint64_t const> b) noexcept
+{
+    size_t const common = intersection_count(a, b);
+    size_t const united = a.size() + b.size() - common;
+    return united == 0 ? 0.0 : static_cast<double>(common) / united;
+}
+
+/*!\brief The Mash distance of a Jaccard index, an estimate of the mutation rate between two sequences.
+ * \param[in] jaccard The Jaccard index of the k-mer sketches.
+ * \param[in] kmer    The k-mer size.
+ * \returns `-ln(2j / (1 + j)) / k`, infinity if `jaccard` is 0.
+ * \throws std::invalid_argument if `kmer` is 0.
+ * \ingroup search_views
+ */
+inline double mash_distance(double const jaccard, size_t const kmer)
+{
+    if (kmer == 0)
+        throw std::invalid_argument{"The chosen kmer is not valid. Please choose a value greater than 0."};
+
+    if (jaccard <= 0.0)
+        return std::numeric_limits<double>::infinity();
+
+    return -std::log(2.0 * jaccard / (1.0 + jaccard)) / kmer;
+}
+
+/*!\brief The Mash distance of two sketches of k-mers.
+ * \ingroup search_views
+ */
+inline double mash_distance(std::span<uint64_t const> a, std::span<uint64_t const> b, size_t const kmer)
+{
+    return mash_distance(jaccard(a, b), kmer);
+}
+} // namespace seqan3
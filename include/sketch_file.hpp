@@ -0,0 +1,500 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Hossein Eizadi Moghadam <hosseinem AT fu-berlin.de>
+ * \brief Provides seqan3::sketch_writer, seqan3::sketch_file and the binary sketch format.
+ */
+
+#pragma once
+
+#include <seqan3/std/algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <seqan3/io/exception.hpp>
+#include "memory_mapping.hpp"
+
+namespace seqan3
+{
+//!\brief The sampling scheme of the hashes of a sketch file.
+enum class sketch_scheme : uint32_t
+{
+    syncmer,     //!< syncmer_hash
+    opensyncmer, //!< opensyncmer_hash
+    minimiser,   //!< seqan3::views::minimiser_hash
+    minstrobe,   //!< minstrobe_hash
+    modmer       //!< modmer_hash
+};
+
+/*!\brief The parameters the hashes of a sketch file were computed with.
+ * \ingroup search_views
+ */
+struct sketch_parameters
+{
+    //!\brief The sampling scheme.
+    sketch_scheme scheme{sketch_scheme::syncmer};
+    //!\brief The k-mer size.
+    uint32_t kmer{};
+    //!\brief The s-mer size, e.g. the shape size of minimiser_hash.
+    uint32_t smer{};
+    //!\brief The window size, e.g. of minimiser_hash, or 0 if the scheme has none.
+    uint32_t window{};
+    //!\brief The seed the hashes were computed with.
+    uint64_t seed{0x8F3F73B5CF1C9ADE};
+    //!\brief The size of a seqan3::bottom_sketch the hashes were reduced to, or 0.
+    uint32_t sketch_size{};
+    //!\brief The scale of a seqan3::scaled_sketch the hashes were reduced to, or 0.
+    uint64_t scale{};
+
+    //!\brief Compares all parameters.
+    friend bool operator==(sketch_parameters const &, sketch_parameters const &) = default;
+};
+
+namespace detail
+{
+//!\brief The first bytes of a sketch file.
+inline constexpr char sketch_magic[8]{'S', 'Y', 'N', 'C', 'S', 'K', 'C', 'H'};
+
+//!\brief The version of the sketch format written by seqan3::sketch_writer.
+inline constexpr uint32_t sketch_version{2};
+
+/*!\brief The header at the start of a sketch file.
+ * \details The header and the index are written as they are in memory, so their integers are in the byte order of the
+ *          writing machine and files are only portable between machines of the same byte order; on the other order
+ *          the version does not match and seqan3::sketch_file rejects the file. The varints of the hashes do not
+ *          depend on the byte order. The offsets are relative to the start of the file.
+ */
+struct sketch_header
+{
+    char magic[8]{};
+    uint32_t version{};
+    sketch_scheme scheme{};
+    uint32_t kmer{};
+    uint32_t smer{};
+    uint32_t window{};
+    uint32_t sketch_size{};
+    uint64_t seed{};
+    uint64_t scale{};
+    uint64_t sketch_count{};
+    uint64_t index_offset{};
+    uint64_t names_offset{};
+};
+
+static_assert(sizeof(sketch_header) == 72);
+
+//!\brief The index entry of one sketch; the index is an array of entries at the end of the file.
+struct sketch_entry
+{
+    //!\brief The offset of the encoded hashes.
+    uint64_t offset{};
+    //!\brief The number of bytes of the encoded hashes.
+    uint64_t size{};
+    //!\brief The number of hashes.
+    uint64_t count{};
+    //!\brief The offset of the name in the names block.
+    uint32_t name_offset{};
+    //!\brief The length of the name.
+    uint32_t name_length{};
+};
+
+static_assert(sizeof(sketch_entry) == 32);
+} // namespace detail
+
+/*!\brief A view that decodes the hashes of a sketch while iterating.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * The hashes are stored in increasing order as the differences to their predecessors (the first to 0), each
+ * difference as a LEB128 varint: 7 bits per byte, least significant group first, the highest bit set on all but the
+ * last byte. Syncmer sketches of bacterial genomes have differences of about 2^64 / number of hashes, e.g. 7 or 8
+ * bytes for a million hashes instead of 8, and dense sketches are much smaller.
+ */
+class sketch_view : public std::ranges::view_interface<sketch_view>
+{
+public:
+    //!\brief The iterator; decodes one varint per increment.
+    class iterator
+    {
+    public:
+        using value_type = uint64_t; //!< The hash type.
+        using reference = uint64_t; //!< Hashes are decoded when they are read.
+        using difference_type = std::ptrdiff_t; //!< The difference type.
+        using iterator_category = std::input_iterator_tag; //!< The iterator category.
+        using iterator_concept = std::forward_iterator_tag; //!< The iterator concept.
+
+        iterator() = default; //!< Defaulted.
+
+        //!\brief Construct at the first of `count` hashes encoded in `[position, end)`.
+        iterator(unsigned char const * position, unsigned char const * end, uint64_t const count) noexcept :
+            position{position},
+            end{end},
+            remaining{count}
+        {
+            decode();
+        }
+
+        //!\brief The current hash.
+        uint64_t operator*() const noexcept
+        {
+            return hash;
+        }
+
+        //!\brief Decodes the next hash.
+        iterator & operator++() noexcept
+        {
+            --remaining;
+            decode();
+            return *this;
+        }
+
+        //!\brief Decodes the next hash and returns the previous position.
+        iterator operator++(int) noexcept
+        {
+            iterator previous{*this};
+            ++(*this);
+            return previous;
+        }
+
+        //!\brief Compares the positions.
+        friend bool operator==(iterator const & lhs, iterator const & rhs) noexcept
+        {
+            return lhs.remaining == rhs.remaining;
+        }
+
+        //!\brief Whether all hashes have been decoded.
+        friend bool operator==(iterator const & it, std::default_sentinel_t) noexcept
+        {
+            return it.remaining == 0;
+        }
+
+    private:
+        //!\brief The next encoded difference.
+        unsigned char const * position{nullptr};
+        //!\brief Behind the encoded hashes; a corrupt varint is never read past it.
+        unsigned char const * end{nullptr};
+        //!\brief The number of hashes from the current one on.
+        uint64_t remaining{0};
+        //!\brief The current hash.
+        uint64_t hash{0};
+
+        //!\brief Adds the next difference to the current hash.
+        void decode() noexcept
+        {
+            if (remaining == 0)
+                return;
+
+            uint64_t difference{0};
+            for (unsigned shift = 0; position != end; shift += 7)
+            {
+                unsigned char const byte = *position++;
+                if (shift < 64)
+                    difference |= static_cast<uint64_t>(byte & 0x7Fu) << shift;
+                if (!(byte & 0x80u))
+                    break;
+            }
+            hash += difference;
+        }
+    };
+
+    sketch_view() = default; //!< Defaulted.
+
+    //!\brief Construct from the encoded hashes and their number.
+    sketch_view(std::string_view const bytes, uint64_t const count) noexcept : bytes{bytes}, count{count}
+    {}
+
+    //!\brief The first hash.
+    iterator begin() const noexcept
+    {
+        unsigned char const * const first = reinterpret_cast<unsigned char const *>(bytes.data());
+        return {first, first + bytes.size(), count};
+    }
+
+    //!\brief Behind the last hash.
+    std::default_sentinel_t end() const noexcept
+    {
+        return {};
+    }
+
+    //!\brief The number of hashes.
+    uint64_t size() const noexcept
+    {
+        return count;
+    }
+
+private:
+    //!\brief The encoded hashes.
+    std::string_view bytes{};
+    //!\brief The number of hashes.
+    uint64_t count{};
+};
+
+/*!\brief Writes sketches, e.g. the sorted hashes of syncmer_hash, to a binary sketch file.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * A sketch file is a 72 byte header with the seqan3::sketch_parameters, the encoded hashes of all sketches (see
+ * seqan3::sketch_view), the names of the sketches and an index with the offset, size, number of hashes and name of
+ * every sketch. The encoded hashes are written as sketches are added, so only the index and the names are kept in
+ * memory; the names and the index are written by finish(). Read the file with seqan3::sketch_file.
+ */
+class sketch_writer
+{
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    sketch_writer() = delete; //!< Deleted.
+    sketch_writer(sketch_writer const &) = delete; //!< Deleted.
+    sketch_writer(sketch_writer &&) = default; //!< Defaulted.
+    sketch_writer & operator=(sketch_writer const &) = delete; //!< Deleted.
+    sketch_writer & operator=(sketch_writer &&) = default; //!< Defaulted.
+
+    //!\brief Calls finish(); errors are ignored, call finish() before to observe them.
+    ~sketch_writer()
+    {
+        try
+        {
+            finish();
+        }
+        catch (...)
+        {}
+    }
+
+    /*!\brief Creates or truncates a sketch file.
+     * \param[in] path       The sketch file.
+     * \param[in] parameters The parameters of the hashes.
+     * \throws seqan3::file_open_error if the file cannot be created.
+     */
+    sketch_writer(std::filesystem::path const & path, sketch_parameters const & parameters) :
+        file{path, std::ios::binary | std::ios::trunc}
+    {
+        if (!file)
+            throw file_open_error{"Could not create the sketch file " + path.string() + "."};
+        file.exceptions(std::ios::badbit | std::ios::failbit);
+
+        std::memcpy(header.magic, detail::sketch_magic, sizeof(header.magic));
+        header.version = detail::sketch_version;
+        header.scheme = parameters.scheme;
+        header.kmer = parameters.kmer;
+        header.smer = parameters.smer;
+        header.window = parameters.window;
+        header.seed = parameters.seed;
+        header.sketch_size = parameters.sketch_size;
+        header.scale = parameters.scale;
+        write(header);
+    }
+    //!\}
+
+    /*!\brief Appends a sketch.
+     * \param[in] name   The name of the sketch, e.g. the id of the sequence.
+     * \param[in] hashes The hashes; they are sorted and duplicates are removed.
+     * \throws std::ios_base::failure if the file cannot be written.
+     */
+    template <std::ranges::input_range rng_t>
+    void add(std::string_view const name, rng_t && hashes)
+    {
+        sorted.clear();
+        for (uint64_t const hash : hashes)
+            sorted.push_back(hash);
+        std::ranges::sort(sorted);
+        sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+        encoded.clear();
+        uint64_t previous{0};
+        for (uint64_t const hash : sorted)
+        {
+            for (uint64_t difference = hash - previous; ; difference >>= 7)
+            {
+                encoded.push_back(static_cast<char>((difference & 0x7Fu) | (difference > 0x7Fu ? 0x80u : 0u)));
+                if (difference <= 0x7Fu)
+                    break;
+            }
+            previous = hash;
+        }
+
+        entries.push_back({offset, encoded.size(), sorted.size(), static_cast<uint32_t>(names.size()),
+                           static_cast<uint32_t>(name.size())});
+        names.append(name);
+        file.write(encoded.data(), encoded.size());
+        offset += encoded.size();
+    }
+
+    /*!\brief Writes the names, the index and the final header; further calls have no effect.
+     * \throws std::ios_base::failure if the file cannot be written.
+     */
+    void finish()
+    {
+        if (finished)
+            return;
+        finished = true;
+
+        header.names_offset = offset;
+        file.write(names.data(), names.size());
+        // The index is aligned to 8 bytes, so it can be read in place from the mapping.
+        offset += names.size();
+        file.write("\0\0\0\0\0\0\0", (8 - offset % 8) % 8);
+        header.index_offset = offset + (8 - offset % 8) % 8;
+        file.write(reinterpret_cast<char const *>(entries.data()), entries.size() * sizeof(detail::sketch_entry));
+
+        header.sketch_count = entries.size();
+        file.seekp(0);
+        write(header);
+        file.close();
+    }
+
+private:
+    //!\brief The sketch file.
+    std::ofstream file{};
+    //!\brief The header, completed by finish().
+    detail::sketch_header header{};
+    //!\brief The index entries of the sketches added so far.
+    std::vector<detail::sketch_entry> entries{};
+    //!\brief The names of the sketches added so far.
+    std::string names{};
+    //!\brief The offset of the next encoded sketch.
+    uint64_t offset{sizeof(detail::sketch_header)};
+    //!\brief Whether finish() was called.
+    bool finished{false};
+    //!\brief The sorted hashes of the sketch being added.
+    std::vector<uint64_t> sorted{};
+    //!\brief The encoded hashes of the sketch being added.
+    std::string encoded{};
+
+    //!\brief Writes the header at the current position.
+    void write(detail::sketch_header const & value)
+    {
+        file.write(reinterpret_cast<char const *>(&value), sizeof(value));
+    }
+};
+
+/*!\brief Reads a sketch file written by seqan3::sketch_writer through a memory mapping.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * Opening a file only maps it and checks the header and the index entries, so it takes time linear in the number of
+ * sketches but not in the number of hashes; the hashes of a sketch are decoded while iterating its
+ * seqan3::sketch_view. The pages of sketches that are never read are never loaded. The file can be read from several
+ * threads at once.
+ */
+class sketch_file
+{
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    sketch_file() = delete; //!< Deleted.
+    sketch_file(sketch_file const &) = delete; //!< Deleted.
+    sketch_file(sketch_file &&) = default; //!< Defaulted.
+    sketch_file & operator=(sketch_file const &) = delete; //!< Deleted.
+    sketch_file & operator=(sketch_file &&) = default; //!< Defaulted.
+    ~sketch_file() = default; //!< Defaulted.
+
+    /*!\brief Maps a sketch file.
+     * \param[in] path The sketch file.
+     * \throws seqan3::file_open_error if the file cannot be opened or mapped.
+     * \throws seqan3::format_error if the file is not a complete sketch file of a supported version, its index is
+     *                              misaligned or an entry of the index points outside of the hashes or names.
+     */
+    explicit sketch_file(std::filesystem::path const & path) : mapping{path, MADV_RANDOM}
+    {
+        std::string_view const bytes = mapping.data();
+        if (bytes.size() < sizeof(detail::sketch_header))
+            throw format_error{"The file " + path.string() + " is not a sketch file."};
+
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        if (std::memcmp(header.magic, detail::sketch_magic, sizeof(header.magic)) != 0)
+            throw format_error{"The file " + path.string() + " is not a sketch file."};
+
+        if (header.version != detail::sketch_version)
+            throw format_error{"The sketch file " + path.string() + " has the unsupported version " +
+                               std::to_string(header.version) + "."};
+
+        if (header.index_offset > bytes.size() ||
+            header.sketch_count > (bytes.size() - header.index_offset) / sizeof(detail::sketch_entry) ||
+            header.names_offset < sizeof(detail::sketch_header) || header.names_offset > header.index_offset)
+            throw format_error{"The sketch file " + path.string() + " is truncated."};
+
+        // The index is read in place; the mapping is page-aligned, so an aligned offset gives aligned entries.
+        if (header.index_offset % alignof(detail::sketch_entry) != 0)
+            throw format_error{"The sketch file " + path.string() + " has a misaligned index."};
+
+        entries = {reinterpret_cast<detail::sketch_entry const *>(bytes.data() + header.index_offset),
+                   static_cast<size_t>(header.sketch_count)};
+
+        // Every varint takes at least one byte, so a sketch of `size` bytes has at most `size` hashes.
+        uint64_t const names_size = header.index_offset - header.names_offset;
+        for (detail::sketch_entry const & entry : entries)
+        {
+            if (entry.offset < sizeof(detail::sketch_header) || entry.offset > header.names_offset ||
+                entry.size > header.names_offset - entry.offset || entry.count > entry.size ||
+                entry.name_offset > names_size || entry.name_length > names_size - entry.name_offset)
+                throw format_error{"The sketch file " + path.string() + " has a corrupt index."};
+        }
+    }
+    //!\}
+
+    //!\brief The parameters the hashes were computed with.
+    sketch_parameters parameters() const noexcept
+    {
+        return {header.scheme, header.kmer, header.smer, header.window, header.seed, header.sketch_size,
+                header.scale};
+    }
+
+    //!\brief The number of sketches.
+    size_t size() const noexcept
+    {
+        return entries.size();
+    }
+
+    //!\brief The name of sketch `id`.
+    std::string_view name(size_t const id) const noexcept
+    {
+        return mapping.data().substr(header.names_offset + entries[id].name_offset, entries[id].name_length);
+    }
+
+    //!\brief The number of hashes of sketch `id`.
+    size_t count(size_t const id) const noexcept
+    {
+        return entries[id].count;
+    }
+
+    //!\brief The sorted hashes of sketch `id`, decoded while iterating.
+    sketch_view sketch(size_t const id) const noexcept
+    {
+        return {mapping.data().substr(entries[id].offset, entries[id].size), entries[id].count};
+    }
+
+    //!\brief Decodes the hashes of sketch `id` into `hashes`, replacing its contents.
+    void decode(size_t const id, std::vector<uint64_t> & hashes) const
+    {
+        hashes.clear();
+        hashes.reserve(count(id));
+        for (uint64_t const hash : sketch(id))
+            hashes.push_back(hash);
+    }
+
+private:
+    //!\brief The mapped file.
+    detail::memory_mapping mapping{};
+    //!\brief A copy of the header.
+    detail::sketch_header header{};
+    //!\brief The index, pointing into the mapping.
+    std::span<detail::sketch_entry const> entries{};
+};
+} // namespace seqan3
@@ -0,0 +1,182 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Hossein Eizadi Moghadam <hosseinem AT fu-berlin.de>
+ * \brief Provides seqan3::build_ibf, seqan3::count_ibf and seqan3::ibf_bin_size.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <seqan3/search/dream_index/interleaved_bloom_filter.hpp>
+#include "profiler.hpp"
+
+namespace seqan3
+{
+namespace detail
+{
+/*!\brief Calls `function(task, thread)` for every task in `[0, count)` on a pool of `threads` threads.
+ * \throws The first exception of `function`, after all threads have finished; no task is started after it.
+ */
+template <typename function_t>
+void ibf_parallel_for(size_t const threads, size_t const count, function_t && function)
+{
+    std::atomic<size_t> next{0};
+    std::mutex mutex{};
+    std::exception_ptr error{};
+    auto worker = [&] (size_t const thread) noexcept
+    {
+        try
+        {
+            for (size_t task = next++; task < count; task = next++)
+                function(task, thread);
+        }
+        catch (...)
+        {
+            std::lock_guard lock{mutex};
+            if (!error)
+                error = std::current_exception();
+            next = count;
+        }
+    };
+
+    {
+        std::vector<std::jthread> workers{};
+        for (size_t thread = 1; thread < threads; ++thread)
+            workers.emplace_back(worker, thread);
+        worker(0);
+    }
+
+    if (error)
+        std::rethrow_exception(error);
+}
+} // namespace detail
+
+/*!\brief The number of bits per bin so that a bin with `elements` hashes has the false positive rate `fpr`.
+ * \param[in] elements       The largest number of distinct hashes of a bin.
+ * \param[in] hash_functions The number of hash functions of the interleaved Bloom filter, in [1, 5].
+ * \param[in] fpr            The false positive rate of a single lookup, in (0, 1).
+ * \returns `-h n / ln(1 - fpr^(1 / h))`, at least 1.
+ * \throws std::invalid_argument if `hash_functions` or `fpr` is out of range.
+ * \ingroup search_views
+ *
+ * \details The size of a Bloom filter is proportional to the number of stored hashes, so a sampling scheme with fewer
+ *          hashes per bin at the same sensitivity, e.g. syncmers instead of minimisers, gives a proportionally smaller
+ *          filter at the same false positive rate.
+ */
+inline size_t ibf_bin_size(size_t const elements, size_t const hash_functions, double const fpr)
+{
+    if (hash_functions == 0 || hash_functions > 5)
+        throw std::invalid_argument{"The chosen hash_functions is not valid. Please choose a value in [1, 5]."};
+
+    if (fpr <= 0.0 || fpr >= 1.0)
+        throw std::invalid_argument{"The chosen fpr is not valid. Please choose a value in (0, 1)."};
+
+    double const h = static_cast<double>(hash_functions);
+    double const bits = -h * elements / std::log(1.0 - std::pow(fpr, 1.0 / h));
+    return std::max<size_t>(1, static_cast<size_t>(std::ceil(bits)));
+}
+
+/*!\brief Builds an interleaved Bloom filter from the hashes of many bins in parallel.
+ * \param[in] bin_count      The number of bins, e.g. genomes or clusters.
+ * \param[in] bin_size       The number of bits per bin, e.g. from seqan3::ibf_bin_size.
+ * \param[in] hash_functions The number of hash functions, in [1, 5].
+ * \param[in] threads        The number of threads.
+ * \param[in] fill           Called as `fill(bin, insert)` once per bin; calls `insert(hash)` with every hash of the
+ *                           bin, e.g. for every element of `sequence | syncmer_hash(s, k)` of all sequences of a genome.
+ * \returns The interleaved Bloom filter.
+ * \throws std::invalid_argument if `threads` is 0.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * The bins are streamed, so the hashes of a bin are never stored. A bit of bin `b` lies in the same 64 bit word as
+ * the bits of the bins `64 floor(b / 64)` to `64 floor(b / 64) + 63` and no others, so the bins are filled in groups of
+ * 64 consecutive bins, each group by one thread, and the threads never write the same word. Every bin is a call of
+ * the stage "ibf_fill" of seqan3::profiler, with the inserted hashes as items.
+ */
+template <typename fill_t>
+interleaved_bloom_filter<> build_ibf(size_t const bin_count,
+                                     size_t const bin_size,
+                                     size_t const hash_functions,
+                                     size_t const threads,
+                                     fill_t && fill)
+{
+    if (threads == 0)
+        throw std::invalid_argument{"The chosen number of threads is not valid. Please choose a value greater than 0."};
+
+    interleaved_bloom_filter<> ibf{seqan3::bin_count{bin_count},
+                                   seqan3::bin_size{bin_size},
+                                   seqan3::hash_function_count{hash_functions}};
+
+    size_t const fill_stage = profiler::global().stage("ibf_fill");
+    size_t const group_count = (bin_count + 63) / 64;
+    detail::ibf_parallel_for(threads, group_count, [&] (size_t const group, size_t)
+    {
+        for (size_t bin = group * 64; bin < std::min(bin_count, group * 64 + 64); ++bin)
+        {
+            scoped_timer timer{fill_stage};
+            fill(bin, [&ibf, &timer, bin] (uint64_t const hash)
+            {
+                ibf.emplace(hash, seqan3::bin_index{bin});
+                timer.add_items(1);
+            });
+        }
+    });
+
+    return ibf;
+}
+
+/*!\brief Counts the hashes of every read in every bin of an interleaved Bloom filter.
+ * \param[in] ibf        The interleaved Bloom filter, e.g. from seqan3::build_ibf.
+ * \param[in] reads      The hashes of the reads, e.g. their syncmers.
+ * \param[in] threads    The number of threads.
+ * \param[in] callback   Called as `callback(read, counts)` for every read, where `counts[b]` is the number of hashes
+ *                       of the read in bin `b`; `counts` is only valid during the call. Called concurrently.
+ * \param[in] batch_size The number of reads per task. Default: 1024.
+ * \throws std::invalid_argument if `threads` or `batch_size` is 0.
+ * \ingroup search_views
+ *
+ * \details Every thread has its own counting agent and takes batches of consecutive reads, so the agents are reused
+ *          and the reads of a batch are processed while the filter words they touch are in the cache. Every batch is
+ *          a call of the stage "ibf_count" of seqan3::profiler, with the reads as items.
+ */
+template <typename callback_t>
+void count_ibf(interleaved_bloom_filter<> const & ibf,
+               std::span<std::vector<uint64_t> const> reads,
+               size_t const threads,
+               callback_t && callback,
+               size_t const batch_size = 1024)
+{
+    if (threads == 0 || batch_size == 0)
+        throw std::invalid_argument{"The chosen number of threads and batch_size are not valid. "
+                                    "Please choose values greater than 0."};
+
+    using agent_t = decltype(ibf.template counting_agent<uint16_t>());
+    std::vector<agent_t> agents{};
+    for (size_t thread = 0; thread < threads; ++thread)
+        agents.push_back(ibf.template counting_agent<uint16_t>());
+
+    size_t const count_stage = profiler::global().stage("ibf_count");
+    size_t const batch_count = (reads.size() + batch_size - 1) / batch_size;
+    detail::ibf_parallel_for(threads, batch_count, [&] (size_t const batch, size_t const thread)
+    {
+        scoped_timer timer{count_stage, std::min(reads.size(), (batch + 1) * batch_size) - batch * batch_size};
+        for (size_t read = batch * batch_size; read < std::min(reads.size(), (batch + 1) * batch_size); ++read)
+            callback(read, agents[thread].bulk_count(reads[read]));
+    });
+}
+} // namespace seqan3
@@ -0,0 +1,337 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Hossein Eizadi Moghadam <hosseinem AT fu-berlin.de>
+ * \brief Provides seqan3::syncmer_sketcher and seqan3::minimiser_sketcher.
+ */
+
+#pragma once
+
+#include <seqan3/std/algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <seqan3/alphabet/nucleotide/dna4.hpp>
+#include "multi_seed_hash.hpp"
+#include "profiler.hpp"
+
+namespace seqan3
+{
+/*!\brief Computes the syncmers of a sequence that arrives in chunks, e.g. a chromosome read in fixed-size buffers.
+ * \tparam offsets_t The seqan3::syncmer_offsets at which the smallest s-mer makes a k-mer a syncmer.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * The sketcher holds the state that seqan3::syncmer_view keeps in its iterator, the rolling k-mer and s-mer hashes,
+ * the last `k` ranks and the s-mer hashes of the current window, so a window may span any number of push() calls. The
+ * syncmers of all chunks of a sequence are exactly those of `sequence | offset_syncmer_hash<offsets_t>(smers, kmers,
+ * seed)` on the whole sequence, and the memory is O(k) whatever the length of the sequence. Call finish() before the
+ * first chunk of the next sequence. Every push() is a call of the stage "syncmer_sketcher" of seqan3::profiler.
+ */
+template <typename offsets_t = closed_syncmer_offsets>
+class syncmer_sketcher
+{
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    syncmer_sketcher() = delete; //!< Deleted.
+    syncmer_sketcher(syncmer_sketcher const &) = default; //!< Defaulted.
+    syncmer_sketcher(syncmer_sketcher &&) = default; //!< Defaulted.
+    syncmer_sketcher & operator=(syncmer_sketcher const &) = default; //!< Defaulted.
+    syncmer_sketcher & operator=(syncmer_sketcher &&) = default; //!< Defaulted.
+    ~syncmer_sketcher() = default; //!< Defaulted.
+
+    /*!\brief Construct from the s-mer and k-mer sizes and the seed of syncmer_hash.
+     * \throws std::invalid_argument if `smers` is 0 or not smaller than `kmers`, or the offsets do not fit.
+     */
+    syncmer_sketcher(size_t const smers, size_t const kmers, seed const seed = seqan3::seed{0x8F3F73B5CF1C9ADE}) :
+        smers{smers},
+        kmers{kmers},
+        seed_value{seed.get()},
+        smer_hash{smers},
+        kmer_hash{kmers},
+        ranks(kmers),
+        ring(kmers - std::min(smers, kmers) + 1)
+    {
+        if (smers < 1 || kmers <= smers)
+            throw std::invalid_argument{"The chosen kmers and smers are not valid. "
+                                        "Please choose values greater than 1 and a smer size smaller than the kmer size."};
+
+        syncmer_positions = offsets_t::resolve(kmers - smers + 1);
+        if (std::ranges::any_of(syncmer_positions, [&] (size_t const p) { return p >= kmers - smers + 1; }))
+            throw std::invalid_argument{"The given syncmer offsets do not fit into the given window_size.\n"
+                                        "Please choose a larger window_size or smaller offsets."};
+    }
+    //!\}
+
+    //!\brief Calls `callback(hash)` for every syncmer whose k-mer ends in `chunk`.
+    template <typename callback_t>
+    void push(std::span<dna4 const> const chunk, callback_t && callback)
+    {
+        static size_t const stage = profiler::global().stage("syncmer_sketcher");
+        scoped_timer timer{stage, chunk.size()};
+        size_t const window_size = ring.size();
+        std::array<bool, 1> const expired{true};
+        auto const lane_value = [this] (size_t const index, size_t) { return ring[index]; };
+
+        for (dna4 const character : chunk)
+        {
+            uint8_t const rank = seqan3::to_rank(character);
+            size_t const smer_index = rank_index >= smers ? rank_index - smers : rank_index + kmers - smers;
+            kmer_hash.roll(rank, characters >= kmers ? ranks[rank_index] : 0);
+            smer_hash.roll(rank, characters >= smers ? ranks[smer_index] : 0);
+            ranks[rank_index] = rank;
+            rank_index = rank_index + 1 == kmers ? 0 : rank_index + 1;
+
+            if (++characters < smers)
+                continue;
+
+            // The s-mer `current` ends at this character, the window of the k-mer ending here starts at `start`.
+            uint64_t const current = characters - smers;
+            uint64_t const value = smer_hash.value ^ seed_value;
+            ring[current % window_size] = value;
+            if (current + 1 < window_size)
+                continue;
+
+            uint64_t const start = current + 1 - window_size;
+            if (value < minimum[0])
+            {
+                minimum[0] = value;
+                position[0] = current;
+            }
+
+            if (start == 0 || position[0] < start)
+                detail::scan_lanes<true>(window_size, start, lane_value, expired, minimum, position);
+
+            if (is_syncmer_position(position[0] - start))
+                callback(kmer_hash.value ^ seed_value);
+        }
+    }
+
+    //!\brief Returns the syncmers whose k-mer ends in `chunk`.
+    std::vector<uint64_t> push(std::span<dna4 const> const chunk)
+    {
+        std::vector<uint64_t> hashes{};
+        push(chunk, [&hashes] (uint64_t const hash) { hashes.push_back(hash); });
+        return hashes;
+    }
+
+    //!\brief Ends the sequence; the next chunk starts a new one. Every syncmer has been reported by push() already.
+    template <typename callback_t>
+    void finish(callback_t &&)
+    {
+        reset();
+    }
+
+    //!\brief Ends the sequence; the next chunk starts a new one.
+    void reset() noexcept
+    {
+        characters = 0;
+        rank_index = 0;
+        smer_hash.value = 0;
+        kmer_hash.value = 0;
+        minimum[0] = std::numeric_limits<uint64_t>::max();
+    }
+
+    //!\brief The number of characters pushed since the start of the sequence.
+    uint64_t size() const noexcept
+    {
+        return characters;
+    }
+
+private:
+    //!\brief The s-mer size.
+    size_t smers{};
+    //!\brief The k-mer size.
+    size_t kmers{};
+    //!\brief The seed.
+    uint64_t seed_value{};
+    //!\brief The resolved offsets of `offsets_t`.
+    std::array<size_t, offsets_t::size> syncmer_positions{};
+
+    //!\brief The hash of the last s-mer.
+    detail::rolling_hash<4> smer_hash;
+    //!\brief The hash of the last k-mer.
+    detail::rolling_hash<4> kmer_hash;
+    //!\brief The ranks of the last k characters, a ring buffer.
+    std::vector<uint8_t> ranks{};
+    //!\brief The index of the oldest rank.
+    size_t rank_index{};
+    //!\brief The seeded s-mer hashes of the current window, a ring buffer indexed by s-mer position.
+    std::vector<uint64_t> ring{};
+    //!\brief The number of characters of the sequence so far.
+    uint64_t characters{};
+    //!\brief The smallest s-mer hash of the window.
+    std::array<uint64_t, 1> minimum{std::numeric_limits<uint64_t>::max()};
+    //!\brief The position of the smallest s-mer hash, the leftmost one in case of ties.
+    std::array<uint64_t, 1> position{};
+
+    //!\brief Whether the smallest s-mer at `offset` makes the k-mer a syncmer; unrolled without branches.
+    bool is_syncmer_position(uint64_t const offset) const noexcept
+    {
+        return [&] <size_t ...idx> (std::index_sequence<idx...>)
+        {
+            return ((offset == syncmer_positions[idx]) | ...);
+        }(std::make_index_sequence<offsets_t::size>{});
+    }
+};
+
+/*!\brief Computes the minimisers of a sequence that arrives in chunks, e.g. a chromosome read in fixed-size buffers.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * The counterpart of seqan3::syncmer_sketcher for `sequence | seqan3::views::minimiser_hash(shape, window_size, seed)`
+ * with an ungapped shape: the forward and reverse complement hashes are rolled and the seeded smaller one of every
+ * k-mer of the current window is kept, so the memory is O(window size). The minimisers of all chunks of a sequence and
+ * of finish() are exactly those of minimiser_hash on the whole sequence. finish() only reports a minimiser for a
+ * sequence shorter than the window, for which minimiser_hash returns the smallest hash of all its k-mers. Every push()
+ * is a call of the stage "minimiser_sketcher" of seqan3::profiler.
+ */
+class minimiser_sketcher
+{
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    minimiser_sketcher() = delete; //!< Deleted.
+    minimiser_sketcher(minimiser_sketcher const &) = default; //!< Defaulted.
+    minimiser_sketcher(minimiser_sketcher &&) = default; //!< Defaulted.
+    minimiser_sketcher & operator=(minimiser_sketcher const &) = default; //!< Defaulted.
+    minimiser_sketcher & operator=(minimiser_sketcher &&) = default; //!< Defaulted.
+    ~minimiser_sketcher() = default; //!< Defaulted.
+
+    /*!\brief Construct from an ungapped shape, the window size and the seed of minimiser_hash.
+     * \throws std::invalid_argument if the shape is gapped, longer than 32 or longer than the window.
+     */
+    minimiser_sketcher(shape const & shape_,
+                       window_size const window,
+                       seed const seed = seqan3::seed{0x8F3F73B5CF1C9ADE}) :
+        shape_size{shape_.size()},
+        seed_value{seed.get()}
+    {
+        if (shape_.count() != shape_.size() || shape_size > 32)
+            throw std::invalid_argument{"The chosen shape is not valid. Please choose an ungapped shape of at most 32."};
+
+        if (shape_size > window.get())
+            throw std::invalid_argument{"The size of the shape cannot be greater than the window size."};
+
+        mask = shape_size == 32 ? ~uint64_t{0} : (uint64_t{1} << (2 * shape_size)) - 1;
+        ring.resize(window.get() - shape_size + 1);
+    }
+    //!\}
+
+    //!\brief Calls `callback(hash)` for every minimiser reported for a window that ends in `chunk`.
+    template <typename callback_t>
+    void push(std::span<dna4 const> const chunk, callback_t && callback)
+    {
+        static size_t const stage = profiler::global().stage("minimiser_sketcher");
+        scoped_timer timer{stage, chunk.size()};
+        size_t const window_size = ring.size();
+        std::array<bool, 1> const expired{true};
+        auto const lane_value = [this] (size_t const index, size_t) { return ring[index]; };
+
+        for (dna4 const character : chunk)
+        {
+            uint64_t const rank = seqan3::to_rank(character);
+            forward = ((forward << 2) | rank) & mask;
+            reverse = (reverse >> 2) | ((3 - rank) << (2 * (shape_size - 1)));
+
+            if (++characters < shape_size)
+                continue;
+
+            uint64_t const current = characters - shape_size;
+            uint64_t const value = std::min(forward ^ seed_value, reverse ^ seed_value);
+            ring[current % window_size] = value;
+            if (current + 1 < window_size)
+                continue;
+
+            // A minimiser is reported for the first window and when it is replaced or has to be searched again.
+            uint64_t const start = current + 1 - window_size;
+            if (start == 0 || position[0] < start)
+            {
+                detail::scan_lanes<false>(window_size, start, lane_value, expired, minimum, position);
+                callback(minimum[0]);
+            }
+            else if (value < minimum[0])
+            {
+                minimum[0] = value;
+                position[0] = current;
+                callback(minimum[0]);
+            }
+        }
+    }
+
+    //!\brief Returns the minimisers reported for the windows that end in `chunk`.
+    std::vector<uint64_t> push(std::span<dna4 const> const chunk)
+    {
+        std::vector<uint64_t> hashes{};
+        push(chunk, [&hashes] (uint64_t const hash) { hashes.push_back(hash); });
+        return hashes;
+    }
+
+    /*!\brief Ends the sequence; the next chunk starts a new one.
+     * \details Calls `callback(hash)` with the smallest hash of all k-mers if the sequence is shorter than the window
+     *          but not than the shape.
+     */
+    template <typename callback_t>
+    void finish(callback_t && callback)
+    {
+        size_t const kmer_count = characters < shape_size ? 0 : characters - shape_size + 1;
+        if (kmer_count > 0 && kmer_count < ring.size())
+        {
+            std::array<bool, 1> const expired{true};
+            auto const lane_value = [this] (size_t const index, size_t) { return ring[index]; };
+            detail::scan_lanes<false>(kmer_count, 0, lane_value, expired, minimum, position);
+            callback(minimum[0]);
+        }
+        reset();
+    }
+
+    //!\brief Ends the sequence without reporting; the next chunk starts a new one.
+    void reset() noexcept
+    {
+        characters = 0;
+        forward = 0;
+        reverse = 0;
+    }
+
+    //!\brief The number of characters pushed since the start of the sequence.
+    uint64_t size() const noexcept
+    {
+        return characters;
+    }
+
+private:
+    //!\brief The shape size.
+    size_t shape_size{};
+    //!\brief The seed.
+    uint64_t seed_value{};
+    //!\brief The mask of the `2 * shape_size` bits of a hash.
+    uint64_t mask{};
+
+    //!\brief The forward hash of the last k-mer.
+    uint64_t forward{};
+    //!\brief The reverse complement hash of the last k-mer.
+    uint64_t reverse{};
+    //!\brief The seeded smaller hash of every k-mer of the current window, a ring buffer indexed by k-mer position.
+    std::vector<uint64_t> ring{};
+    //!\brief The number of characters of the sequence so far.
+    uint64_t characters{};
+    //!\brief The minimiser of the window.
+    std::array<uint64_t, 1> minimum{};
+    //!\brief The position of the minimiser, the rightmost one in case of ties.
+    std::array<uint64_t, 1> position{};
+};
+} // namespace seqan3
@@ -0,0 +1,612 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Hossein Eizadi Moghadam <hosseinem AT fu-berlin.de>
+ * \brief Provides superkmer.
+ */
+
+#pragma once
+
+#include <seqan3/std/algorithm>
+
+#include <seqan3/core/detail/empty_type.hpp>
+#include <seqan3/core/range/detail/adaptor_from_functor.hpp>
+#include <seqan3/core/range/type_traits.hpp>
+#include <seqan3/utility/range/concept.hpp>
+
+#include "window_buffer.hpp"
+
+namespace seqan3
+{
+/*!\brief A maximal run of consecutive windows that share their minimiser.
+ * \ingroup search_views
+ */
+struct superkmer
+{
+    //!\brief The position of the first character of the superkmer in the text.
+    size_t start{};
+    //!\brief The number of characters of the superkmer.
+    size_t length{};
+    //!\brief The minimiser shared by all windows of the superkmer.
+    uint64_t minimiser{};
+
+    //!\brief Compare two superkmers.
+    friend bool operator==(superkmer const &, superkmer const &) = default;
+};
+} // namespace seqan3
+
+namespace seqan3::detail
+{
+// ---------------------------------------------------------------------------------------------------------------------
+// superkmer_view class
+// ---------------------------------------------------------------------------------------------------------------------
+
+/*!\brief The type returned by superkmer.
+ * \tparam urng1_t The type of the underlying range, must model std::ranges::forward_range, the reference type must
+ *                 model std::totally_ordered and be convertible to `uint64_t`. The typical use case is that the
+ *                 reference type is the result of seqan3::kmer_hash.
+ * \tparam urng2_t The type of the second underlying range, must model std::ranges::forward_range, the reference type
+ *                 must model std::totally_ordered. If only one range is provided this defaults to
+ *                 std::ranges::empty_view.
+ * \implements std::ranges::view
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * The minimiser of each window is determined exactly like in seqan3::detail::minimiser_view, a superkmer ends
+ * whenever seqan3::views::minimiser would return a new minimiser.
+ *
+ * \note Most members of this class are generated by std::ranges::view_interface which is not yet documented here.
+ */
+template <std::ranges::view urng1_t,
+          std::ranges::view urng2_t = std::ranges::empty_view<seqan3::detail::empty_type>>
+class superkmer_view : public std::ranges::view_interface<superkmer_view<urng1_t, urng2_t>>
+{
+private:
+    static_assert(std::ranges::forward_range<urng1_t>, "The superkmer_view only works on forward_ranges.");
+    static_assert(std::ranges::forward_range<urng2_t>, "The superkmer_view only works on forward_ranges.");
+    static_assert(std::totally_ordered<std::ranges::range_reference_t<urng1_t>>,
+                  "The reference type of the underlying range must model std::totally_ordered.");
+
+    //!\brief The default argument of the second range.
+    using default_urng2_t = std::ranges::empty_view<seqan3::detail::empty_type>;
+
+    //!\brief Boolean variable, which is true, when second range is not of empty type.
+    static constexpr bool second_range_is_given = !std::same_as<urng2_t, default_urng2_t>;
+
+    static_assert(!second_range_is_given || std::totally_ordered_with<std::ranges::range_reference_t<urng1_t>,
+                                                                      std::ranges::range_reference_t<urng2_t>>,
+                  "The reference types of the underlying ranges must model std::totally_ordered_with.");
+
+    //!\brief Whether the given ranges are const_iterable
+    static constexpr bool const_iterable = seqan3::const_iterable_range<urng1_t> &&
+                                           seqan3::const_iterable_range<urng2_t>;
+
+    //!\brief The first underlying range.
+    urng1_t urange1{};
+    //!\brief The second underlying range.
+    urng2_t urange2{};
+
+    //!\brief The number of values in one window.
+    size_t window_size{};
+    //!\brief The number of characters covered by one value, i.e. the size of the shape.
+    size_t shape_size{};
+
+    template <bool const_range>
+    class basic_iterator;
+
+    //!\brief The sentinel type of the superkmer_view.
+    using sentinel = std::default_sentinel_t;
+
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    superkmer_view()
+        requires std::default_initializable<urng1_t> && std::default_initializable<urng2_t>
+        = default; //!< Defaulted.
+    superkmer_view(superkmer_view const & rhs) = default; //!< Defaulted.
+    superkmer_view(superkmer_view && rhs) = default; //!< Defaulted.
+    superkmer_view & operator=(superkmer_view const & rhs) = default; //!< Defaulted.
+    superkmer_view & operator=(superkmer_view && rhs) = default; //!< Defaulted.
+    ~superkmer_view() = default; //!< Defaulted.
+
+    /*!\brief Construct from a view, the number of values in one window and the number of characters per value.
+    * \param[in] urange1     The input range to process. Must model std::ranges::viewable_range and
+    *                        std::ranges::forward_range.
+    * \param[in] window_size The number of values in one window.
+    * \param[in] shape_size  The number of characters covered by one value.
+    */
+    superkmer_view(urng1_t urange1, size_t const window_size, size_t const shape_size) :
+        superkmer_view{std::move(urange1), default_urng2_t{}, window_size, shape_size}
+    {}
+
+    /*!\brief Construct from two views, the number of values in one window and the number of characters per value.
+    * \param[in] urange1     The first input range to process. Must model std::ranges::viewable_range and
+    *                        std::ranges::forward_range.
+    * \param[in] urange2     The second input range to process. Must model std::ranges::viewable_range and
+    *                        std::ranges::forward_range.
+    * \param[in] window_size The number of values in one window.
+    * \param[in] shape_size  The number of characters covered by one value.
+    */
+    superkmer_view(urng1_t urange1, urng2_t urange2, size_t const window_size, size_t const shape_size) :
+        urange1{std::move(urange1)},
+        urange2{std::move(urange2)},
+        window_size{window_size},
+        shape_size{shape_size}
+    {
+        if constexpr (second_range_is_given)
+        {
+            if (std::ranges::distance(this->urange1) != std::ranges::distance(this->urange2))
+                throw std::invalid_argument{"The two ranges do not have the same size."};
+        }
+    }
+
+    /*!\brief Construct from two non-views that can be view-wrapped, the number of values in one window and the
+    *         number of characters per value.
+    * \tparam other_urng1_t  The type of another urange. Must model std::ranges::viewable_range and be constructible
+                             from urng1_t.
+    * \tparam other_urng2_t  The type of another urange. Must model std::ranges::viewable_range and be constructible
+                             from urng2_t.
+    * \param[in] urange1     The input range to process. Must model std::ranges::viewable_range and
+    *                        std::ranges::forward_range.
+    * \param[in] urange2     The second input range to process. Must model std::ranges::viewable_range and
+    *                        std::ranges::forward_range.
+    * \param[in] window_size The number of values in one window.
+    * \param[in] shape_size  The number of characters covered by one value.
+    */
+    template <typename other_urng1_t, typename other_urng2_t>
+    //!\cond
+        requires (std::ranges::viewable_range<other_urng1_t> &&
+                  std::constructible_from<urng1_t, std::views::all_t<other_urng1_t>> &&
+                  std::ranges::viewable_range<other_urng2_t> &&
+                  std::constructible_from<urng2_t, std::views::all_t<other_urng2_t>>)
+    //!\endcond
+    superkmer_view(other_urng1_t && urange1,
+                   other_urng2_t && urange2,
+                   size_t const window_size,
+                   size_t const shape_size) :
+        superkmer_view{urng1_t{std::views::all(std::forward<other_urng1_t>(urange1))},
+                       urng2_t{std::views::all(std::forward<other_urng2_t>(urange2))},
+                       window_size,
+                       shape_size}
+    {}
+    //!\}
+
+    /*!\name Iterators
+     * \{
+     */
+    /*!\brief Returns an iterator to the first element of the range.
+     * \returns Iterator to the first element.
+     *
+     * \details
+     *
+     * ### Complexity
+     *
+     * Linear in the length of the first superkmer.
+     *
+     * ### Exceptions
+     *
+     * Strong exception guarantee.
+     */
+    basic_iterator<false> begin()
+    {
+        return {std::ranges::begin(urange1),
+                std::ranges::end(urange1),
+                std::ranges::begin(urange2),
+                window_size,
+                shape_size};
+    }
+
+    //!\copydoc begin()
+    basic_iterator<true> begin() const
+    //!\cond
+        requires const_iterable
+    //!\endcond
+    {
+        return {std::ranges::cbegin(urange1),
+                std::ranges::cend(urange1),
+                std::ranges::cbegin(urange2),
+                window_size,
+                shape_size};
+    }
+
+    /*!\brief Returns an iterator to the element following the last element of the range.
+     * \returns Iterator to the end.
+     *
+     * \details
+     *
+     * This element acts as a placeholder; attempting to dereference it results in undefined behaviour.
+     *
+     * ### Complexity
+     *
+     * Constant.
+     *
+     * ### Exceptions
+     *
+     * No-throw guarantee.
+     */
+    sentinel end() const
+    {
+        return {};
+    }
+    //!\}
+};
+
+//!\brief Iterator for calculating superkmers.
+template <std::ranges::view urng1_t, std::ranges::view urng2_t>
+template <bool const_range>
+class superkmer_view<urng1_t, urng2_t>::basic_iterator
+{
+private:
+    //!\brief The sentinel type of the first underlying range.
+    using urng1_sentinel_t = maybe_const_sentinel_t<const_range, urng1_t>;
+    //!\brief The iterator type of the first underlying range.
+    using urng1_iterator_t = maybe_const_iterator_t<const_range, urng1_t>;
+    //!\brief The iterator type of the second underlying range.
+    using urng2_iterator_t = maybe_const_iterator_t<const_range, urng2_t>;
+    //!\brief The type of the hash values.
+    using hash_t = std::ranges::range_value_t<urng1_t>;
+
+    template <bool>
+    friend class basic_iterator;
+
+public:
+    /*!\name Associated types
+     * \{
+     */
+    //!\brief Type for distances between iterators.
+    using difference_type = std::ranges::range_difference_t<urng1_t>;
+    //!\brief Value type of this iterator.
+    using value_type = seqan3::superkmer;
+    //!\brief The pointer type.
+    using pointer = void;
+    //!\brief Reference to `value_type`.
+    using reference = value_type;
+    //!\brief Tag this class as a forward iterator.
+    using iterator_category = std::forward_iterator_tag;
+    //!\brief Tag this class as a forward iterator.
+    using iterator_concept = iterator_category;
+    //!\}
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    basic_iterator() = default; //!< Defaulted.
+    basic_iterator(basic_iterator const &) = default; //!< Defaulted.
+    basic_iterator(basic_iterator &&) = default; //!< Defaulted.
+    basic_iterator & operator=(basic_iterator const &) = default; //!< Defaulted.
+    basic_iterator & operator=(basic_iterator &&) = default; //!< Defaulted.
+    ~basic_iterator() = default; //!< Defaulted.
+
+    //!\brief Allow iterator on a const range to be constructible from an iterator over a non-const range.
+    basic_iterator(basic_iterator<!const_range> const & it)
+    //!\cond
+        requires const_range
+    //!\endcond
+        : superkmer_value{std::move(it.superkmer_value)},
+          minimiser_value{std::move(it.minimiser_value)},
+          minimiser_position_offset{std::move(it.minimiser_position_offset)},
+          window_position{std::move(it.window_position)},
+          extra_length{std::move(it.extra_length)},
+          at_end{std::move(it.at_end)},
+          input_exhausted{std::move(it.input_exhausted)},
+          urng1_iterator{std::move(it.urng1_iterator)},
+          urng1_sentinel{std::move(it.urng1_sentinel)},
+          urng2_iterator{std::move(it.urng2_iterator)},
+          window_values{std::move(it.window_values)}
+    {}
+
+    /*!\brief Construct from begin and end iterators of a given range over std::totally_ordered values, the number
+              of values per window and the number of characters per value.
+    * \param[in] urng1_iterator Iterator pointing to the first position of the first std::totally_ordered range.
+    * \param[in] urng1_sentinel Iterator pointing to the last position of the first std::totally_ordered range.
+    * \param[in] urng2_iterator Iterator pointing to the first position of the second std::totally_ordered range.
+    * \param[in] window_size    The number of values in one window.
+    * \param[in] shape_size     The number of characters covered by one value.
+    *
+    * \details
+    *
+    * Computes the minimiser of the first window and extends the first superkmer until the minimiser changes.
+    */
+    basic_iterator(urng1_iterator_t urng1_iterator,
+                   urng1_sentinel_t urng1_sentinel,
+                   urng2_iterator_t urng2_iterator,
+                   size_t window_size,
+                   size_t shape_size) :
+        urng1_iterator{std::move(urng1_iterator)},
+        urng1_sentinel{std::move(urng1_sentinel)},
+        urng2_iterator{std::move(urng2_iterator)}
+    {
+        size_t size = std::ranges::distance(this->urng1_iterator, this->urng1_sentinel);
+        window_size = std::min<size_t>(window_size, size);
+
+        if (window_size == 0u)
+        {
+            at_end = true;
+            return;
+        }
+
+        extra_length = window_size + shape_size - 2;
+        window_first(window_size);
+        next_superkmer();
+    }
+    //!\}
+
+    //!\anchor basic_iterator_comparison_superkmer
+    //!\name Comparison operators
+    //!\{
+
+    //!\brief Compare to another basic_iterator.
+    friend bool operator==(basic_iterator const & lhs, basic_iterator const & rhs)
+    {
+        return (lhs.at_end == rhs.at_end) && (lhs.window_position == rhs.window_position);
+    }
+
+    //!\brief Compare to another basic_iterator.
+    friend bool operator!=(basic_iterator const & lhs, basic_iterator const & rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    //!\brief Compare to the sentinel of the superkmer_view.
+    friend bool operator==(basic_iterator const & lhs, sentinel const &)
+    {
+        return lhs.at_end;
+    }
+
+    //!\brief Compare to the sentinel of the superkmer_view.
+    friend bool operator==(sentinel const & lhs, basic_iterator const & rhs)
+    {
+        return rhs == lhs;
+    }
+
+    //!\brief Compare to the sentinel of the superkmer_view.
+    friend bool operator!=(sentinel const & lhs, basic_iterator const & rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    //!\brief Compare to the sentinel of the superkmer_view.
+    friend bool operator!=(basic_iterator const & lhs, sentinel const & rhs)
+    {
+        return !(lhs == rhs);
+    }
+    //!\}
+
+    //!\brief Pre-increment.
+    basic_iterator & operator++() noexcept
+    {
+        if (input_exhausted)
+            at_end = true;
+        else
+            next_superkmer();
+        return *this;
+    }
+
+    //!\brief Post-increment.
+    basic_iterator operator++(int) noexcept
+    {
+        basic_iterator tmp{*this};
+        ++*this;
+        return tmp;
+    }
+
+    //!\brief Return the superkmer.
+    value_type operator*() const noexcept
+    {
+        return superkmer_value;
+    }
+
+private:
+    //!\brief The current superkmer.
+    value_type superkmer_value{};
+
+    //!\brief The minimiser of the current window.
+    hash_t minimiser_value{};
+
+    //!\brief The offset relative to the beginning of the window where the minimizer value is found.
+    size_t minimiser_position_offset{};
+
+    //!\brief The position of the current window, i.e. of its first value.
+    size_t window_position{};
+
+    //!\brief The number of characters of a superkmer in addition to its number of windows.
+    size_t extra_length{};
+
+    //!\brief Whether the iterator is past the last superkmer.
+    bool at_end{false};
+
+    //!\brief Whether the last window of the range was reached.
+    bool input_exhausted{false};
+
+    //!\brief Iterator to the rightmost value of one window.
+    urng1_iterator_t urng1_iterator{};
+    //!brief Iterator to last element in range.
+    urng1_sentinel_t urng1_sentinel{};
+    //!\brief Iterator to the rightmost value of one window of the second range.
+    urng2_iterator_t urng2_iterator{};
+
+    //!\brief Stored values per window. It is necessary to store them, because a shift can remove the current minimiser.
+    window_buffer<hash_t> window_values{};
+
+    //!\brief Returns new window value.
+    auto window_value() const
+    {
+        if constexpr (!second_range_is_given)
+            return *urng1_iterator;
+        else
+            return std::min(*urng1_iterator, *urng2_iterator);
+    }
+
+    //!\brief Advances the window to the next position.
+    void advance_window()
+    {
+        ++urng1_iterator;
+        if constexpr (second_range_is_given)
+            ++urng2_iterator;
+    }
+
+    //!\brief Calculates the minimiser of the first window.
+    void window_first(size_t const window_size)
+    {
+        for (size_t i = 0u; i < window_size - 1u; ++i)
+        {
+            window_values.push_back(window_value());
+            advance_window();
+        }
+        window_values.push_back(window_value());
+        auto minimiser_it = std::ranges::min_element(window_values, std::less_equal<hash_t>{});
+        minimiser_value = *minimiser_it;
+        minimiser_position_offset = std::distance(std::begin(window_values), minimiser_it);
+    }
+
+    /*!\brief Shifts the window by one and calculates its minimiser.
+     * \returns True, if the minimiser changed or the end is reached. Otherwise returns false.
+     */
+    bool next_window()
+    {
+        advance_window();
+        if (urng1_iterator == urng1_sentinel)
+        {
+            input_exhausted = true;
+            return true;
+        }
+
+        ++window_position;
+        hash_t const new_value = window_value();
+
+        window_values.pop_front();
+        window_values.push_back(new_value);
+
+        if (minimiser_position_offset == 0)
+        {
+            auto minimiser_it = std::ranges::min_element(window_values, std::less_equal<hash_t>{});
+            minimiser_value = *minimiser_it;
+            minimiser_position_offset = std::distance(std::begin(window_values), minimiser_it);
+            return true;
+        }
+
+        if (new_value < minimiser_value)
+        {
+            minimiser_value = new_value;
+            minimiser_position_offset = window_values.size() - 1;
+            return true;
+        }
+
+        --minimiser_position_offset;
+        return false;
+    }
+
+    //!\brief Starts a superkmer at the current window and extends it until the minimiser changes.
+    void next_superkmer()
+    {
+        superkmer_value.start = window_position;
+        superkmer_value.minimiser = minimiser_value;
+
+        while (!next_window()) {}
+
+        superkmer_value.length = window_position - superkmer_value.start + extra_length + input_exhausted;
+    }
+};
+
+//!\brief A deduction guide for the view class template.
+template <std::ranges::viewable_range rng1_t>
+superkmer_view(rng1_t &&, size_t const window_size, size_t const shape_size) ->
+    superkmer_view<std::views::all_t<rng1_t>>;
+
+//!\brief A deduction guide for the view class template.
+template <std::ranges::viewable_range rng1_t, std::ranges::viewable_range rng2_t>
+superkmer_view(rng1_t &&, rng2_t &&, size_t const window_size, size_t const shape_size) ->
+    superkmer_view<std::views::all_t<rng1_t>, std::views::all_t<rng2_t>>;
+
+// ---------------------------------------------------------------------------------------------------------------------
+// superkmer_fn (adaptor definition)
+// ---------------------------------------------------------------------------------------------------------------------
+
+//![adaptor_def]
+//!\brief superkmer's range adaptor object type (non-closure).
+//!\ingroup search_views
+struct superkmer_fn
+{
+    //!\brief Store the number of values in one window and the shape size and return a range adaptor closure object.
+    constexpr auto operator()(size_t const window_size, size_t const shape_size) const
+    {
+        return adaptor_from_functor{*this, window_size, shape_size};
+    }
+
+    /*!\brief Call the view's constructor with the underlying view, the number of values in one window and the number
+     *        of characters covered by one value.
+     * \tparam urng1_t        The type of the input range to process. Must model std::ranges::viewable_range.
+     * \param[in] urange1     The input range to process. Must model std::ranges::viewable_range and
+     *                        std::ranges::forward_range.
+     * \param[in] window_size The number of values in one window.
+     * \param[in] shape_size  The number of characters covered by one value.
+     * \returns  A range of seqan3::superkmer.
+     */
+    template <std::ranges::range urng1_t>
+    constexpr auto operator()(urng1_t && urange1, size_t const window_size, size_t const shape_size) const
+    {
+        static_assert(std::ranges::viewable_range<urng1_t>,
+                      "The range parameter to views::superkmer cannot be a temporary of a non-view range.");
+        static_assert(std::ranges::forward_range<urng1_t>,
+                      "The range parameter to views::superkmer must model std::ranges::forward_range.");
+
+        if (window_size == 0 || shape_size == 0)
+            throw std::invalid_argument{"The chosen window_size or shape_size is not valid. "
+                                        "Please choose values greater than 0."};
+
+        return superkmer_view{urange1, window_size, shape_size};
+    }
+};
+//![adaptor_def]
+
+} // namespace seqan3::detail
+
+namespace seqan3::views
+{
+/*!\brief Computes superkmers for a range of comparable values. A superkmer is a maximal run of consecutive windows
+ *        that share their minimiser.
+ * \tparam urng_t The type of the first range being processed. See below for requirements. [template
+ *                 parameter is omitted in pipe notation]
+ * \param[in] urange1     The range being processed. [parameter is omitted in pipe notation]
+ * \param[in] window_size The number of values in one window.
+ * \param[in] shape_size  The number of characters covered by one value, used to report the superkmer in characters.
+ * \returns A range of seqan3::superkmer. See below for the properties of the returned range.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * Every window of the range belongs to exactly one superkmer, consecutive superkmers overlap by
+ * `window_size + shape_size - 2` characters. For example for the hash values `[28, 100, 9, 23, 4, 1, 72, 37, 8]`,
+ * 4 as `window_size` and 1 as `shape_size`, the superkmers are `(0, 4, 9)`, `(1, 4, 4)` and `(2, 7, 1)`.
+ *
+ * ### View properties
+ *
+ * | Concepts and traits              | `urng_t` (underlying range type)   | `rrng_t` (returned range type)   |
+ * |----------------------------------|:----------------------------------:|:--------------------------------:|
+ * | std::ranges::input_range         | *required*                         | *preserved*                      |
+ * | std::ranges::forward_range       | *required*                         | *preserved*                      |
+ * | std::ranges::bidirectional_range |                                    | *lost*                           |
+ * | std::ranges::random_access_range |                                    | *lost*                           |
+ * | std::ranges::contiguous_range    |                                    | *lost*                           |
+ * |                                  |                                    |                                  |
+ * | std::ranges::viewable_range      | *required*                         | *guaranteed*                     |
+ * | std::ranges::view                |                                    | *guaranteed*                     |
+ * | std::ranges::sized_range         |                                    | *lost*                           |
+ * | std::ranges::common_range        |                                    | *lost*                           |
+ * | std::ranges::output_range        |                                    | *lost*                           |
+ * | seqan3::const_iterable_range     |                                    | *preserved*                      |
+ * |                                  |                                    |                                  |
+ * | std::ranges::range_reference_t   | std::totally_ordered               | seqan3::superkmer                |
+ *
+ * See the views views submodule documentation for detailed descriptions of the view properties.
+ */
+inline constexpr auto superkmer = detail::superkmer_fn{};
+
+} // namespace seqan3::views
@@ -13,7 +13,8 @@
 #pragma once
 
 #include <seqan3/std/algorithm>
-#include <deque>
+#include <array>
+#include <utility>
 
 #include <seqan3/core/detail/empty_type.hpp>
 #include <seqan3/core/range/detail/adaptor_from_functor.hpp>
@@ -21,6 +22,95 @@
 #include <seqan3/utility/range/concept.hpp>
 #include <seqan3/utility/type_traits/lazy_conditional.hpp>
 
+#include "sampling_stats.hpp"
+#include "window_buffer.hpp"
+
+namespace seqan3
+{
+/*!\brief A position inside a k-mer at which the smallest s-mer makes the k-mer a syncmer.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * The number of s-mers in a k-mer (k - s + 1) is only known once k and s are chosen, so an offset is anchored at the
+ * start, the middle or the end of the k-mer and shifted by `shift` positions towards the middle. The anchor and the
+ * shift are template arguments of seqan3::syncmer_offsets, the numeric position is resolved once per iterator.
+ * The middle anchor resolves to the 0-based position of \f$t = \lceil(k - s + 1) / 2\rceil\f$, the offset with the
+ * best conservation for open syncmers.
+ */
+struct syncmer_offset
+{
+    //!\brief Where the offset is counted from.
+    enum class anchor : uint8_t
+    {
+        start,  //!< Counted from the first s-mer of the k-mer.
+        middle, //!< Counted from the middle s-mer of the k-mer.
+        end     //!< Counted from the last s-mer of the k-mer, towards the start.
+    };
+
+    //!\brief The anchor of the offset.
+    anchor from{anchor::start};
+    //!\brief The number of positions between the anchor and the offset.
+    size_t shift{0};
+
+    /*!\brief Returns the 0-based position of the offset.
+     * \param[in] window_size The number of s-mers in one k-mer (k - s + 1).
+     * \returns The position; a value not smaller than `window_size` means the offset does not fit into the k-mer.
+     */
+    constexpr size_t resolve(size_t const window_size) const noexcept
+    {
+        switch (from)
+        {
+            case anchor::middle:
+                return (window_size - 1) / 2 + shift;
+            case anchor::end:
+                return (shift < window_size) ? window_size - 1 - shift : window_size;
+            default:
+                return shift;
+        }
+    }
+};
+
+/*!\brief The set of offsets at which the smallest s-mer makes a k-mer a syncmer.
+ * \tparam offsets The allowed seqan3::syncmer_offset values; at least one must be given.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * The set is a template argument of seqan3::detail::syncmer_view, so the check whether the position of the smallest
+ * s-mer is an allowed offset is unrolled into `sizeof...(offsets)` comparisons without any loop or branch.
+ */
+template <syncmer_offset ...offsets>
+struct syncmer_offsets
+{
+    static_assert(sizeof...(offsets) > 0, "At least one syncmer offset must be given.");
+
+    //!\brief The number of allowed offsets.
+    static constexpr size_t size = sizeof...(offsets);
+
+    /*!\brief Resolves all offsets for a given number of s-mers per k-mer.
+     * \param[in] window_size The number of s-mers in one k-mer (k - s + 1).
+     */
+    static constexpr std::array<size_t, size> resolve(size_t const window_size) noexcept
+    {
+        return {offsets.resolve(window_size)...};
+    }
+};
+
+//!\brief Closed syncmers: the smallest s-mer is at the start or at the end of the k-mer.
+//!\ingroup search_views
+using closed_syncmer_offsets = syncmer_offsets<syncmer_offset{syncmer_offset::anchor::start},
+                                               syncmer_offset{syncmer_offset::anchor::end}>;
+
+//!\brief Open syncmers: the smallest s-mer is at the start of the k-mer.
+//!\ingroup search_views
+using open_syncmer_offsets = syncmer_offsets<syncmer_offset{syncmer_offset::anchor::start}>;
+
+//!\brief Open syncmers with the offset \f$t = \lceil(k - s + 1) / 2\rceil\f$, i.e. the smallest s-mer is in the middle.
+//!\ingroup search_views
+using middle_syncmer_offsets = syncmer_offsets<syncmer_offset{syncmer_offset::anchor::middle}>;
+} // namespace seqan3
+
 namespace seqan3::detail
 {
 // ---------------------------------------------------------------------------------------------------------------------
@@ -35,15 +125,16 @@ namespace seqan3::detail
  *                 type must model std::totally_ordered. The typical use case is that the reference type is the
  *                 result of seqan3::kmer_hash.
  *
- * \tparam opensyncmer If false, syncmers are used but if ture, open-syncmers are used. Default: False.
+ * \tparam offsets_t The seqan3::syncmer_offsets at which the smallest s-mer makes a k-mer a syncmer.
+ *                   Default: seqan3::closed_syncmer_offsets.
  * \implements std::ranges::view
  * \ingroup search_views
  *
  * \note Most members of this class are generated by std::ranges::view_interface which is not yet documented here.
 
  */
-template <std::ranges::view urng1_t, std::ranges::view urng2_t, bool opensyncmer = false>
-class syncmer_view : public std::ranges::view_interface<syncmer_view<urng1_t, urng2_t>>
+template <std::ranges::view urng1_t, std::ranges::view urng2_t, typename offsets_t = seqan3::closed_syncmer_offsets>
+class syncmer_view : public std::ranges::view_interface<syncmer_view<urng1_t, urng2_t, offsets_t>>
 {
 private:
     static_assert(std::ranges::forward_range<urng1_t>, "The syncmer_view only works on forward_ranges.");
@@ -70,6 +161,23 @@ private:
     //!\brief The sentinel type of the syncmer_view.
     using sentinel = std::default_sentinel_t;
 
+    //!\brief Whether both ranges are bidirectional and common, then end() is an iterator that can be decremented.
+    template <typename rng1_t, typename rng2_t>
+    static constexpr bool common_bidirectional = std::ranges::bidirectional_range<rng1_t> &&
+                                                 std::ranges::common_range<rng1_t> &&
+                                                 std::ranges::bidirectional_range<rng2_t> &&
+                                                 std::ranges::common_range<rng2_t>;
+
+    //!\brief The number of windows of the first range, which is the position of the end iterator; 0 if not sized.
+    template <typename rng_t>
+    size_t window_count(rng_t & range) const
+    {
+        if constexpr (std::ranges::sized_range<rng_t>)
+            return std::ranges::size(range) + 1 > window_size ? std::ranges::size(range) + 1 - window_size : 0;
+        else
+            return 0;
+    }
+
 public:
     /*!\name Constructors, destructor andt assignment
      * \{
@@ -161,7 +269,9 @@ public:
      *
      * \details
      *
-     * This element acts as a placeholder; attempting to dereference it results in undefined behaviour.
+     * This element acts as a placeholder; attempting to dereference it results in undefined behaviour. If both
+     * underlying ranges are bidirectional and common, it is an iterator, so the view is a common range and
+     * `std::views::reverse` starts at the last syncmer without traversing the range; otherwise it is a sentinel.
      *
      * ### Complexity
      *
@@ -171,17 +281,44 @@ public:
      *
      * No-throw guarantee.
      */
-    sentinel end() const
+    auto end()
+    {
+        if constexpr (common_bidirectional<urng1_t, urng2_t>)
+            return basic_iterator<false>{std::ranges::end(urange1), std::ranges::end(urange2), window_size,
+                                         window_count(urange1)};
+        else
+            return sentinel{};
+    }
+
+    //!\copydoc end()
+    auto end() const
+    //!\cond
+        requires const_iterable && const_iterable2
+    //!\endcond
     {
-        return {};
+        if constexpr (common_bidirectional<urng1_t const, urng2_t const>)
+            return basic_iterator<true>{std::ranges::cend(urange1), std::ranges::cend(urange2), window_size,
+                                        window_count(urange1)};
+        else
+            return sentinel{};
     }
     //!\}
+
+    /*!\brief Traverses the view and returns the counters of its iterator, see seqan3::sampling_stats.
+     * \details All counters are 0 unless SEQAN3_SAMPLING_STATS is 1.
+     */
+    sampling_stats stats()
+    {
+        auto it = begin();
+        for (; it != end(); ++it) {}
+        return it.stats();
+    }
 };
 
 //!\brief Iterator for calculating syncmers.
-template <std::ranges::view urng1_t, std::ranges::view urng2_t, bool opensyncmer>
+template <std::ranges::view urng1_t, std::ranges::view urng2_t, typename offsets_t>
 template <bool const_range>
-class syncmer_view<urng1_t, urng2_t, opensyncmer>::basic_iterator
+class syncmer_view<urng1_t, urng2_t, offsets_t>::basic_iterator
 {
 private:
     //!\brief The sentinel type of the first underlying range.
@@ -206,9 +343,12 @@ public:
     using pointer = void;
     //!\brief Reference to `value_type`.
     using reference = value_type;
-    //!\brief Tag this class as a forward iterator.
-    using iterator_category = std::forward_iterator_tag;
-    //!\brief Tag this class as a forward iterator.
+    //!\brief Tag this class as a bidirectional iterator if both underlying ranges are bidirectional.
+    using iterator_category = std::conditional_t<std::bidirectional_iterator<urng1_iterator_t> &&
+                                                 std::bidirectional_iterator<urng2_iterator_t>,
+                                                 std::bidirectional_iterator_tag,
+                                                 std::forward_iterator_tag>;
+    //!\brief Tag this class as a bidirectional iterator if both underlying ranges are bidirectional.
     using iterator_concept = iterator_category;
     //!\}
 
@@ -228,10 +368,15 @@ public:
         requires const_range
     //!\endcond
         : syncmer_value{std::move(it.syncmer_value)},
+          syncmer_position_offset{std::move(it.syncmer_position_offset)},
           urng1_iterator{std::move(it.urng1_iterator)},
           urng2_iterator{std::move(it.urng2_iterator)},
           urng1_sentinel{std::move(it.urng1_sentinel)},
-          w_size{std::move(it.w_size)}
+          window_values{std::move(it.window_values)},
+          w_size{std::move(it.w_size)},
+          syncmer_positions{std::move(it.syncmer_positions)},
+          window_position{it.window_position},
+          counters{it.counters}
     {}
 
     /*!\brief Construct from begin and end iterators of a given range over std::totally_ordered values, and the number
@@ -243,8 +388,8 @@ public:
     *
     * \details
     *
-    * Looks at the number of values per window in two ranges, if the smallest subwindow in a window is at its start
-    * or end, it returns the window as a syncmer and shifts then by one to repeat this action.
+    * Looks at the number of values per window in two ranges, if the smallest subwindow in a window is at one of the
+    * offsets given by `offsets_t`, it returns the window as a syncmer and shifts then by one to repeat this action.
     */
     basic_iterator(urng1_iterator_t urng1_iterator,
                    urng2_iterator_t urng2_iterator,
@@ -259,8 +404,36 @@ public:
         if (window_size > size)
             throw std::invalid_argument{"The given sequence is too short to satisfy the given window_size.\n"
                                         "Please choose a smaller window_size."};
-        window_first(window_size);
+
+        syncmer_positions = offsets_t::resolve(window_size);
+        if (std::ranges::any_of(syncmer_positions, [window_size] (size_t const p) { return p >= window_size; }))
+            throw std::invalid_argument{"The given syncmer offsets do not fit into the given window_size.\n"
+                                        "Please choose a larger window_size or smaller offsets."};
+
+        if (!window_first(window_size))
+            next_unique_syncmer();
     }
+
+    /*!\brief Construct the end iterator of common ranges, which can be decremented to the last syncmer.
+    * \param[in] urng1_end    Iterator pointing behind the last position of the first std::totally_ordered range.
+    * \param[in] urng2_end    Iterator pointing behind the last position of the second std::totally_ordered range.
+    * \param[in] window_size The number of elements in one window (should be window size - subwindow size + 1).
+    * \param[in] window_count The number of windows, see position().
+    */
+    basic_iterator(urng1_iterator_t urng1_end,
+                   urng2_iterator_t urng2_end,
+                   size_t const window_size,
+                   size_t const window_count)
+    //!\cond
+        requires std::same_as<urng1_iterator_t, urng1_sentinel_t>
+    //!\endcond
+        : urng1_iterator{urng1_end},
+          urng2_iterator{std::move(urng2_end)},
+          urng1_sentinel{std::move(urng1_end)},
+          w_size{window_size},
+          syncmer_positions{offsets_t::resolve(window_size)},
+          window_position{window_count}
+    {}
     //!\}
 
     //!\anchor basic_iterator_comparison_syncmer
@@ -321,6 +494,94 @@ public:
         return tmp;
     }
 
+    /*!\brief Pre-decrement.
+     * \details From the end, the last window is read again; otherwise the window is shifted back by one s-mer at a
+     *          time. The s-mer entering at the front is read through a second iterator, which is placed once with
+     *          std::ranges::prev and then moved along, so consecutive decrements roll the hash backwards.
+     */
+    basic_iterator & operator--() noexcept
+    //!\cond
+        requires std::bidirectional_iterator<urng1_iterator_t> && std::bidirectional_iterator<urng2_iterator_t>
+    //!\endcond
+    {
+        if (urng1_iterator == urng1_sentinel && window_last())
+            return *this;
+
+        while (!previous_syncmer()) {}
+        return *this;
+    }
+
+    //!\brief Post-decrement.
+    basic_iterator operator--(int) noexcept
+    //!\cond
+        requires std::bidirectional_iterator<urng1_iterator_t> && std::bidirectional_iterator<urng2_iterator_t>
+    //!\endcond
+    {
+        basic_iterator tmp{*this};
+        --(*this);
+        return tmp;
+    }
+
+    /*!\brief The position of the current window, the index of its first s-mer and of its k-mer.
+     * \details For an iterator obtained from end() of a range that is not sized, the position is unspecified.
+     */
+    size_t position() const noexcept
+    {
+        return window_position;
+    }
+
+    //!\brief The work of the forward traversal so far; all counters are 0 unless SEQAN3_SAMPLING_STATS is 1.
+    sampling_stats stats() const noexcept
+    {
+        return counters.stats();
+    }
+
+    /*!\brief Moves to the first syncmer whose k-mer starts at `position` or later.
+     * \param[in] position The index of a k-mer; positions behind the last k-mer move the iterator to the end.
+     * \details
+     *
+     * Only the window at `position` is read, so a region of a long sequence or a chunk processed by one thread starts
+     * in O(window size) steps instead of scanning from the beginning. The syncmers from here on are the same as in a
+     * traversal from the beginning.
+     */
+    basic_iterator & seek(size_t const position)
+    //!\cond
+        requires std::random_access_iterator<urng1_iterator_t> && std::random_access_iterator<urng2_iterator_t> &&
+                 std::sized_sentinel_for<urng1_sentinel_t, urng1_iterator_t>
+    //!\endcond
+    {
+        difference_type const skip = static_cast<difference_type>(position) -
+                                     static_cast<difference_type>(window_position);
+        difference_type const remaining = urng1_sentinel - urng1_iterator;
+        urng1_front_valid = false;
+
+        if (skip >= remaining)
+        {
+            urng1_iterator += remaining;
+            urng2_iterator += remaining;
+            window_position += remaining;
+            return *this;
+        }
+
+        urng1_iterator += skip;
+        urng2_iterator += skip;
+        window_position = position;
+
+        window_values.clear();
+        for (difference_type back = w_size - 1; back >= 0; --back)
+            window_values.push_back(*(urng1_iterator - back));
+
+        auto smallest_s_it = std::ranges::min_element(window_values, std::less<value_type>{});
+        syncmer_position_offset = std::distance(std::begin(window_values), smallest_s_it);
+
+        if (is_syncmer_position())
+            syncmer_value = *urng2_iterator;
+        else
+            next_unique_syncmer();
+
+        return *this;
+    }
+
     //!\brief Return the syncmer.
     value_type operator*() const noexcept
     {
@@ -340,15 +601,30 @@ private:
     //!\brief Iterator to the rightmost value of one kmer in the second range.
     urng2_iterator_t urng2_iterator{};
 
+    //!\brief Iterator to the leftmost value of the window; only maintained while decrementing.
+    urng1_iterator_t urng1_front{};
+
+    //!\brief Whether `urng1_front` points to the leftmost value of the window.
+    bool urng1_front_valid{false};
+
     //!brief Iterator to last element in range.
     urng1_sentinel_t urng1_sentinel{};
 
     //!\brief Stored values per window. It is necessary to store them, because a shift can remove the current syncmer.
-    std::deque<value_type> window_values{};
+    detail::window_buffer<value_type> window_values{};
 
     //!brief The number of elements in one window.
     size_t w_size{};
 
+    //!\brief The resolved offsets of `offsets_t` at which the smallest subwindow makes the window a syncmer.
+    std::array<size_t, offsets_t::size> syncmer_positions{};
+
+    //!\brief The index of the first value of the current window in the first range.
+    size_t window_position{};
+
+    //!\brief The counters of stats().
+    [[no_unique_address]] detail::sampling_counters<> counters{};
+
     //!\brief Increments iterator by 1.
     void next_unique_syncmer()
     {
@@ -360,14 +636,27 @@ private:
     {
         ++urng1_iterator;
         ++urng2_iterator;
+        urng1_front_valid = false;
+        ++window_position;
     }
 
-    //!\brief Calculates syncmers for the first window.
-    void window_first(const size_t window_size)
+    //!\brief Whether the smallest subwindow is at one of the syncmer offsets; unrolled without branches.
+    bool is_syncmer_position() const noexcept
+    {
+        return [this] <size_t ...idx> (std::index_sequence<idx...>)
+        {
+            return ((syncmer_position_offset == syncmer_positions[idx]) | ...);
+        }(std::make_index_sequence<offsets_t::size>{});
+    }
+
+    /*!\brief Calculates syncmers for the first window.
+     * \returns True, if the first window is a syncmer. Otherwise returns false.
+     */
+    bool window_first(const size_t window_size)
     {
         w_size = window_size;
         if (window_size == 0u)
-            return;
+            return true;
 
         for (int i = 0u; i < w_size - 1 ; ++i)
         {
@@ -378,30 +667,25 @@ private:
 
         auto smallest_s_it = std::ranges::min_element(window_values, std::less<value_type>{});
         syncmer_position_offset = std::distance(std::begin(window_values), smallest_s_it);
+        counters.position();
+        counters.rescan(w_size);
 
-        if constexpr (opensyncmer)
+        if (is_syncmer_position())
         {
-            if (syncmer_position_offset == 0)
-            {
-                auto syncmer_it = urng2_iterator;
-                syncmer_value = *syncmer_it;
-            }
-        }
-        else
-        {
-            if (syncmer_position_offset == 0 || syncmer_position_offset == w_size - 1 )
-            {
-                auto syncmer_it = urng2_iterator;
-                syncmer_value = *syncmer_it;
-            }
+            auto syncmer_it = urng2_iterator;
+            syncmer_value = *syncmer_it;
+            counters.sample();
+            return true;
         }
+        return false;
     }
 
     /*!\brief Calculates the next syncmer value.
      * \returns True, if new syncmer is found or end is reached. Otherwise returns false.
      * \details
      * For the following windows, we remove the first window value (is now not in window_values) and add the new
-     * value that results from the window shifting.
+     * value that results from the window shifting. The position of the smallest value is tracked; it only has to be
+     * searched again when the smallest value is shifted out of the window.
      */
     bool next_syncmer()
     {
@@ -411,6 +695,7 @@ private:
             return true;
 
         value_type const new_value = *urng1_iterator;
+        counters.position();
 
         window_values.pop_front();
         window_values.push_back(new_value);
@@ -419,46 +704,99 @@ private:
         {
             auto smallest_s_it = std::ranges::min_element(window_values, std::less<value_type>{});
             syncmer_position_offset = std::distance(std::begin(window_values), smallest_s_it);
-
-            if constexpr (opensyncmer)
-            {
-                if (syncmer_position_offset == 0)
-                {
-                    auto syncmer_it = urng2_iterator;
-                    syncmer_value = *syncmer_it;
-                    return true;
-                }
-            }
-            else
-            {
-                if (syncmer_position_offset == 0 || syncmer_position_offset == w_size - 1 )
-                {
-                    auto syncmer_it = urng2_iterator;
-                    syncmer_value = *syncmer_it;
-                    return true;
-                }
-            }
+            counters.rescan(w_size);
         }
-
         else if (new_value < *(window_values.begin()+(syncmer_position_offset-1)))
         {
             syncmer_position_offset = w_size - 1;
-            if constexpr (!opensyncmer)
-            {
-                auto syncmer_it = urng2_iterator;
-                syncmer_value = *syncmer_it;
-                return true;
-            }
         }
-        else if (syncmer_position_offset == 1)
+        else
+        {
+            counters.tie(new_value == *(window_values.begin()+(syncmer_position_offset-1)));
+            --syncmer_position_offset;
+        }
+
+        if (is_syncmer_position())
         {
             auto syncmer_it = urng2_iterator;
             syncmer_value = *syncmer_it;
-            --syncmer_position_offset;
+            counters.sample();
             return true;
         }
+        return false;
+    }
+
+    /*!\brief Reads the last window of the ranges from the end.
+     * \returns True, if the last window is a syncmer. Otherwise returns false.
+     */
+    bool window_last()
+    {
+        --urng1_iterator;
+        --urng2_iterator;
+        --window_position;
+
+        window_values.clear();
+        auto smer_it = urng1_iterator;
+        window_values.push_front(*smer_it);
+        for (size_t i = 1; i < w_size; ++i)
+            window_values.push_front(*--smer_it);
+        urng1_front = smer_it;
+        urng1_front_valid = true;
 
-        --syncmer_position_offset;
+        auto smallest_s_it = std::ranges::min_element(window_values, std::less<value_type>{});
+        syncmer_position_offset = std::distance(std::begin(window_values), smallest_s_it);
+
+        if (is_syncmer_position())
+        {
+            syncmer_value = *urng2_iterator;
+            return true;
+        }
+        return false;
+    }
+
+    /*!\brief Calculates the previous syncmer value.
+     * \returns True, if the window is a syncmer. Otherwise returns false.
+     * \details
+     * The mirror image of next_syncmer(): the last window value is removed and the value before the window is added
+     * at the front. Ties are resolved to the leftmost position as in the forward direction, so the state equals the
+     * one of a forward traversal reaching the same window.
+     */
+    bool previous_syncmer()
+    {
+        --urng1_iterator;
+        --urng2_iterator;
+        --window_position;
+
+        if (!urng1_front_valid)
+            urng1_front = std::ranges::prev(urng1_iterator, w_size - 1);
+        else
+            --urng1_front;
+        urng1_front_valid = true;
+
+        value_type const new_value = *urng1_front;
+
+        window_values.pop_back();
+        window_values.push_front(new_value);
+
+        if (syncmer_position_offset == w_size - 1)
+        {
+            auto smallest_s_it = std::ranges::min_element(window_values, std::less<value_type>{});
+            syncmer_position_offset = std::distance(std::begin(window_values), smallest_s_it);
+        }
+        else if (new_value <= *(window_values.begin() + (syncmer_position_offset + 1)))
+        {
+            syncmer_position_offset = 0;
+        }
+        else
+        {
+            ++syncmer_position_offset;
+        }
+
+        if (is_syncmer_position())
+        {
+            syncmer_value = *urng2_iterator;
+            return true;
+        }
         return false;
     }
 };
@@ -469,16 +807,15 @@ private:
 template <std::ranges::viewable_range rng1_t, std::ranges::viewable_range rng2_t>
 syncmer_view(rng1_t &&, rng2_t &&, size_t const window_size) -> syncmer_view<std::views::all_t<rng1_t>, std::views::all_t<rng2_t>>;
 
-template <std::ranges::viewable_range rng1_t, std::ranges::viewable_range rng2_t, bool opn>
-syncmer_view(rng1_t &&, rng2_t &&, size_t const window_size) -> syncmer_view<std::views::all_t<rng1_t>, std::views::all_t<rng2_t>, opn>;
-
 // ---------------------------------------------------------------------------------------------------------------------
 // syncmer_fn (adaptor definition)
 // ---------------------------------------------------------------------------------------------------------------------
 
 //![adaptor_def]
 //!\brief syncmer's range adaptor object type (non-closure).
+//!\tparam offsets_t The seqan3::syncmer_offsets at which the smallest s-mer makes a k-mer a syncmer.
 //!\ingroup search_views
+template <typename offsets_t = seqan3::closed_syncmer_offsets>
 struct syncmer_fn
 {
     //!\brief Store the number of values in one window and return a range adaptor closure object.
@@ -511,7 +848,9 @@ struct syncmer_fn
             throw std::invalid_argument{"The chosen window_size is not valid."
                                         "Please choose a subwindow size greater than 0 and a window size greater than the subwindow size."};
 
-        return syncmer_view{urange1, urange2, window_size};
+        return syncmer_view<std::views::all_t<urng1_t>, std::views::all_t<urng2_t>, offsets_t>{urange1,
+                                                                                                 urange2,
+                                                                                                 window_size};
     }
 };
 //![adaptor_def]
@@ -538,7 +877,14 @@ namespace seqan3::views
  * (s < k) at its start or end. An open-syncmer has its smer at its start. For example for the following sequence
  * `ACGGCGACGTT` and 5 as `window size`, 2 as `subwindow size`, the closed-syncmer values are 
  * `ACGGC,CGGCG,GCGAC,ACGTT` and the open-syncmer values are `ACGGC,CGGCG,ACGTT`.
- * 
+ *
+ * ### Syncmer offsets
+ *
+ * Closed and open syncmers are two instances of (k, s, t)-syncmers, where t is the set of positions at which the
+ * smallest s-mer makes the k-mer a syncmer. seqan3::views::offset_syncmer takes this set as seqan3::syncmer_offsets,
+ * e.g. `seqan3::views::offset_syncmer<seqan3::middle_syncmer_offsets>` selects open syncmers with the offset
+ * \f$t = \lceil(k - s + 1) / 2\rceil\f$, which are better conserved under mutations than open syncmers with t = 1
+ * at the same density.
  *
  *
  * ### View properties
@@ -547,14 +893,14 @@ namespace seqan3::views
  * |----------------------------------|:----------------------------------:|:--------------------------------:|
  * | std::ranges::input_range         | *required*                         | *preserved*                      |
  * | std::ranges::forward_range       | *required*                         | *preserved*                      |
- * | std::ranges::bidirectional_range |                                    | *lost*                           |
+ * | std::ranges::bidirectional_range |                                    | *preserved*                      |
  * | std::ranges::random_access_range |                                    | *lost*                           |
  * | std::ranges::contiguous_range    |                                    | *lost*                           |
  * |                                  |                                    |                                  |
  * | std::ranges::viewable_range      | *required*                         | *guaranteed*                     |
  * | std::ranges::view                |                                    | *guaranteed*                     |
  * | std::ranges::sized_range         |                                    | *lost*                           |
- * | std::ranges::common_range        |                                    | *lost*                           |
+ * | std::ranges::common_range        |                                    | *preserved*                      |
  * | std::ranges::output_range        |                                    | *lost*                           |
  * | seqan3::const_iterable_range     |                                    | *preserved*                      |
  * |                                  |                                    |                                  |
@@ -562,6 +908,14 @@ namespace seqan3::views
  *
  * See the views views submodule documentation for detailed descriptions of the view properties.
  */
-inline constexpr auto syncmer = detail::syncmer_fn{};
+inline constexpr auto syncmer = detail::syncmer_fn<>{};
+
+/*!\brief Computes (k, s, t)-syncmers for a range of comparable values, where t is given by `offsets_t`.
+ * \tparam offsets_t The seqan3::syncmer_offsets at which the smallest s-mer makes a k-mer a syncmer.
+ * \ingroup search_views
+ * \sa seqan3::views::syncmer
+ */
+template <typename offsets_t>
+inline constexpr auto offset_syncmer = detail::syncmer_fn<offsets_t>{};
 
 } // namespace seqan3::views
@@ -23,7 +23,9 @@
 namespace seqan3::detail
 {
 //!\brief seqan3::views::syncmer_hash's range adaptor object type (non-closure).
+//!\tparam offsets_t The seqan3::syncmer_offsets at which the smallest s-mer makes a k-mer a syncmer.
 //!\ingroup search_views
+template <typename offsets_t = seqan3::closed_syncmer_offsets>
 struct syncmer_hash_fn
 {
     /*!\brief Store the kmers and the smers and return a range adaptor closure object.
@@ -85,7 +87,8 @@ struct syncmer_hash_fn
                                                  | std::views::transform([seed] (uint64_t i)
                                                           {return i ^ seed.get();});
 
-        return seqan3::detail::syncmer_view(smers_hash, kmers_hash, kmers - smers + 1);
+        return seqan3::detail::syncmer_view<decltype(smers_hash), decltype(kmers_hash), offsets_t>
+                                                 (smers_hash, kmers_hash, kmers - smers + 1);
     }
 };
 
@@ -116,14 +119,14 @@ struct syncmer_hash_fn
  * |----------------------------------|:----------------------------------:|:--------------------------------:|
  * | std::ranges::input_range         | *required*                         | *preserved*                      |
  * | std::ranges::forward_range       | *required*                         | *preserved*                      |
- * | std::ranges::bidirectional_range |                                    | *lost*                           |
+ * | std::ranges::bidirectional_range |                                    | *preserved*                      |
  * | std::ranges::random_access_range |                                    | *lost*                           |
  * | std::ranges::contiguous_range    |                                    | *lost*                           |
  * |                                  |                                    |                                  |
  * | std::ranges::viewable_range      | *required*                         | *guaranteed*                     |
  * | std::ranges::view                |                                    | *guaranteed*                     |
  * | std::ranges::sized_range         |                                    | *lost*                           |
- * | std::ranges::common_range        |                                    | *lost*                           |
+ * | std::ranges::common_range        |                                    | *preserved*                      |
  * | std::ranges::output_range        |                                    | *lost*                           |
  * | seqan3::const_iterable_range     |                                    | *preserved*                      |
  * |                                  |                                    |                                  |
@@ -134,6 +137,21 @@ struct syncmer_hash_fn
  * \hideinitializer
  *
  */
-inline constexpr auto syncmer_hash = seqan3::detail::syncmer_hash_fn{};
+inline constexpr auto syncmer_hash = seqan3::detail::syncmer_hash_fn<>{};
+
+/*!\brief                     Computes (k, s, t)-syncmers for a range with given window and subwindow sizes, and seed.
+ * \tparam offsets_t          The seqan3::syncmer_offsets at which the smallest s-mer makes a k-mer a syncmer, e.g.
+ *                            seqan3::middle_syncmer_offsets for open syncmers with \f$t = \lceil(k - s + 1) / 2\rceil\f$.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * Takes the same arguments as syncmer_hash, which is `offset_syncmer_hash<seqan3::closed_syncmer_offsets>`.
+ * The offsets are resolved once per iterator, the per-position check compiles down to one comparison per offset.
+ *
+ * \hideinitializer
+ */
+template <typename offsets_t>
+inline constexpr auto offset_syncmer_hash = seqan3::detail::syncmer_hash_fn<offsets_t>{};
 
 //!\}
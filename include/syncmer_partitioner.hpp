@@ -0,0 +1,138 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Hossein Eizadi Moghadam <hosseinem AT fu-berlin.de>
+ * \brief Provides seqan3::syncmer_partitioner.
+ */
+
+#pragma once
+
+#include <cassert>
+
+#include <seqan3/search/views/kmer_hash.hpp>
+#include "bucket_writer.hpp"
+#include "syncmer.hpp"
+
+namespace seqan3
+{
+/*!\brief Splits sequences into syncmer-anchored segments and writes them to on-disk buckets.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * Every k-mer of length `kmer_size` is assigned to the leftmost closed syncmer of length `syncmer_size` it contains.
+ * Any `syncmer_size - smer_size` consecutive syncmer candidates contain a closed syncmer, so every k-mer contains one
+ * if `kmer_size >= 2 * syncmer_size - smer_size - 1`, and the anchor of a k-mer only depends on the k-mer itself.
+ * The k-mers sharing an anchor are consecutive; they are written as one segment to the bucket given by the prefix of
+ * the anchor's hash (seqan3::bucket_writer::bucket_of).
+ *
+ * All occurrences of a k-mer are thus in the same bucket and every k-mer of a sequence is in exactly one segment, so
+ * each bucket can be counted or indexed on its own, by a separate thread or process and without a shared table.
+ * Segments overlap by `kmer_size - 1` characters, like superkmers.
+ *
+ * A partitioner is not thread-safe; to partition in parallel, give each thread its own partitioner with a distinct
+ * prefix and process bucket `i` of all prefixes together.
+ */
+class syncmer_partitioner
+{
+public:
+    /*!\brief Construct from a file prefix, the number of buckets and the k-mer, syncmer and s-mer sizes.
+     * \param[in] prefix       The path prefix of the bucket files, see seqan3::bucket_writer.
+     * \param[in] bucket_count The number of buckets.
+     * \param[in] kmer_size    The size of the k-mers that are partitioned.
+     * \param[in] syncmer_size The size of the closed syncmers used as anchors.
+     * \param[in] smer_size    The s-mer size of the syncmers.
+     * \param[in] buffer_size  The number of bytes buffered per bucket before it is written. Default: 1 MiB.
+     * \throws std::invalid_argument if the sizes do not guarantee a syncmer in every k-mer.
+     * \throws seqan3::file_open_error if a bucket file cannot be created.
+     */
+    syncmer_partitioner(std::filesystem::path prefix,
+                        size_t const bucket_count,
+                        size_t const kmer_size,
+                        size_t const syncmer_size,
+                        size_t const smer_size,
+                        size_t const buffer_size = 1u << 20) :
+        writer{std::move(prefix), bucket_count, buffer_size},
+        kmer_size{kmer_size},
+        syncmer_size{syncmer_size},
+        smer_size{smer_size}
+    {
+        if (smer_size < 1 || syncmer_size <= smer_size)
+            throw std::invalid_argument{"The chosen syncmer_size and smer_size are not valid. "
+                                        "Please choose values greater than 1 and a smer size smaller than the "
+                                        "syncmer size."};
+
+        if (kmer_size + smer_size + 1 < 2 * syncmer_size)
+            throw std::invalid_argument{"The chosen kmer_size is too small to contain a syncmer in every k-mer. "
+                                        "Please choose kmer_size >= 2 * syncmer_size - smer_size - 1."};
+    }
+
+    /*!\brief Writes the segments of a sequence to their buckets.
+     * \param[in] sequence The sequence, its characters must model seqan3::semialphabet with at most 4 values.
+     */
+    template <std::ranges::random_access_range rng_t>
+        requires std::ranges::sized_range<rng_t>
+    void push(rng_t && sequence)
+    {
+        size_t const size = std::ranges::size(sequence);
+        if (size < kmer_size)
+            return;
+
+        size_t const last_kmer = size - kmer_size;
+        auto sequence_view = std::views::all(std::forward<rng_t>(sequence));
+        auto smers_hash = sequence_view | views::kmer_hash(shape{ungapped{static_cast<uint8_t>(smer_size)}});
+        auto syncmers_hash = sequence_view | views::kmer_hash(shape{ungapped{static_cast<uint8_t>(syncmer_size)}});
+
+        // The syncmer_view over the candidate positions returns the positions of the syncmers.
+        auto syncmer_positions = detail::syncmer_view(smers_hash,
+                                                      std::views::iota(size_t{0}, size - syncmer_size + 1),
+                                                      syncmer_size - smer_size + 1);
+        auto syncmer_hash_it = std::ranges::begin(syncmers_hash);
+        size_t syncmer_hash_position{0};
+        size_t next_kmer{0};
+
+        for (size_t const position : syncmer_positions)
+        {
+            std::ranges::advance(syncmer_hash_it, position - syncmer_hash_position);
+            syncmer_hash_position = position;
+
+            size_t const segment_end = std::min(position, last_kmer) + kmer_size;
+            writer.push(writer.bucket_of(*syncmer_hash_it), sequence_view | std::views::drop(next_kmer)
+                                                                          | std::views::take(segment_end - next_kmer));
+
+            next_kmer = position + 1;
+            if (next_kmer > last_kmer)
+                break;
+        }
+
+        assert(next_kmer > last_kmer);
+    }
+
+    //!\brief Appends the buffers of all buckets to their files.
+    void flush()
+    {
+        writer.flush();
+    }
+
+    //!\brief The underlying seqan3::bucket_writer, e.g. for seqan3::bucket_writer::bucket_path.
+    bucket_writer const & buckets() const noexcept
+    {
+        return writer;
+    }
+
+private:
+    //!\brief The buckets the segments are written to.
+    bucket_writer writer;
+    //!\brief The size of the k-mers that are partitioned.
+    size_t kmer_size{};
+    //!\brief The size of the closed syncmers used as anchors.
+    size_t syncmer_size{};
+    //!\brief The s-mer size of the syncmers.
+    size_t smer_size{};
+};
+} // namespace seqan3
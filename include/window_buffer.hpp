@@ -0,0 +1,289 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Hossein Eizadi Moghadam <hosseinem AT fu-berlin.de>
+ * \brief Provides seqan3::detail::window_buffer.
+ */
+
+#pragma once
+
+#include <seqan3/std/algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace seqan3::detail
+{
+/*!\brief The values of the window of a sampling iterator, stored inside the iterator up to a fixed window size.
+ * \tparam value_t         The type of the values, must be std::semiregular.
+ * \tparam inline_capacity The largest window that is stored without heap memory.
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * Replaces the std::deque of the iterators of syncmer_view, opensyncmer_view, minimiser_view, minstrobe_view and
+ * superkmer_view with the part of its interface they use. The values are contiguous in a buffer of at least twice the
+ * window size and are moved back to the middle of the buffer when they reach one of its ends, so pushing and popping
+ * at both ends is amortised constant and the window is searched through plain pointers.
+ *
+ * Windows of up to `inline_capacity` values live in an array inside the object: the iterators do not allocate, and
+ * copying one only copies the values of its window. Larger windows move to a std::vector on the first push that does
+ * not fit, and copies of such iterators allocate as before.
+ */
+template <std::semiregular value_t, size_t inline_capacity = 32>
+class window_buffer
+{
+public:
+    //!\brief The type of the values.
+    using value_type = value_t;
+    //!\brief The iterator type; a pointer into the buffer.
+    using iterator = value_t *;
+    //!\brief The const iterator type; a pointer into the buffer.
+    using const_iterator = value_t const *;
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    //!\brief An empty window; the inline buffer is left uninitialised.
+    window_buffer() noexcept
+    {}
+
+    //!\brief Copies the values of the window only.
+    window_buffer(window_buffer const & other)
+    {
+        assign(other);
+    }
+
+    //!\brief Takes the heap buffer of `other` if it has one, otherwise copies its values.
+    window_buffer(window_buffer && other) noexcept(std::is_nothrow_copy_assignable_v<value_t>)
+    {
+        assign(std::move(other));
+    }
+
+    //!\brief Copies the values of the window only.
+    window_buffer & operator=(window_buffer const & other)
+    {
+        if (this != &other)
+            assign(other);
+        return *this;
+    }
+
+    //!\brief Takes the heap buffer of `other` if it has one, otherwise copies its values.
+    window_buffer & operator=(window_buffer && other) noexcept(std::is_nothrow_copy_assignable_v<value_t>)
+    {
+        if (this != &other)
+            assign(std::move(other));
+        return *this;
+    }
+
+    ~window_buffer() = default; //!< Defaulted.
+    //!\}
+
+    //!\brief The first value of the window.
+    iterator begin() noexcept
+    {
+        return data() + first;
+    }
+
+    //!\copydoc begin()
+    const_iterator begin() const noexcept
+    {
+        return data() + first;
+    }
+
+    //!\brief Behind the last value of the window.
+    iterator end() noexcept
+    {
+        return data() + last;
+    }
+
+    //!\copydoc end()
+    const_iterator end() const noexcept
+    {
+        return data() + last;
+    }
+
+    //!\brief The number of values in the window.
+    size_t size() const noexcept
+    {
+        return last - first;
+    }
+
+    //!\brief Whether the window is empty.
+    bool empty() const noexcept
+    {
+        return first == last;
+    }
+
+    //!\brief The value at `index` from the front.
+    value_t & operator[](size_t const index) noexcept
+    {
+        return data()[first + index];
+    }
+
+    //!\copydoc operator[]()
+    value_t const & operator[](size_t const index) const noexcept
+    {
+        return data()[first + index];
+    }
+
+    //!\brief The first value.
+    value_t & front() noexcept
+    {
+        return data()[first];
+    }
+
+    //!\copydoc front()
+    value_t const & front() const noexcept
+    {
+        return data()[first];
+    }
+
+    //!\brief The last value.
+    value_t & back() noexcept
+    {
+        return data()[last - 1];
+    }
+
+    //!\copydoc back()
+    value_t const & back() const noexcept
+    {
+        return data()[last - 1];
+    }
+
+    //!\brief Appends a value.
+    void push_back(value_t const value)
+    {
+        if (last == capacity())
+            make_room();
+        data()[last++] = value;
+    }
+
+    //!\brief Prepends a value.
+    void push_front(value_t const value)
+    {
+        if (first == 0u)
+            make_room();
+        data()[--first] = value;
+    }
+
+    //!\brief Removes the first value.
+    void pop_front() noexcept
+    {
+        ++first;
+    }
+
+    //!\brief Removes the last value.
+    void pop_back() noexcept
+    {
+        --last;
+    }
+
+    //!\brief Removes all values; a heap buffer is kept for the next window.
+    void clear() noexcept
+    {
+        first = last = capacity() / 2;
+    }
+
+private:
+    //!\brief The buffer of small windows; not initialised, only `[first, last)` is read.
+    std::array<value_t, 2 * inline_capacity> inline_values;
+
+    //!\brief The buffer of windows larger than `inline_capacity`; empty while the window fits inline.
+    std::vector<value_t> heap_values{};
+
+    //!\brief The index of the first value in the buffer.
+    size_t first{inline_capacity};
+
+    //!\brief The index behind the last value in the buffer.
+    size_t last{inline_capacity};
+
+    //!\brief The buffer in use.
+    value_t * data() noexcept
+    {
+        return heap_values.empty() ? inline_values.data() : heap_values.data();
+    }
+
+    //!\copydoc data()
+    value_t const * data() const noexcept
+    {
+        return heap_values.empty() ? inline_values.data() : heap_values.data();
+    }
+
+    //!\brief The size of the buffer in use.
+    size_t capacity() const noexcept
+    {
+        return heap_values.empty() ? inline_values.size() : heap_values.size();
+    }
+
+    /*!\brief Moves the values to the middle of the buffer, after moving to a larger buffer if the window and one more
+     *        value would take more than half of it.
+     * \details
+     * A buffer of at least twice the window size leaves a quarter of it free at both ends, so the values are moved at
+     * most once per `capacity() / 4` pushes.
+     */
+    void make_room()
+    {
+        size_t const count = size();
+        size_t const new_first = std::max<size_t>(std::bit_ceil(2 * (count + 1)), capacity()) / 2 - count / 2;
+
+        if (2 * (count + 1) > capacity())
+        {
+            std::vector<value_t> larger(std::bit_ceil(2 * (count + 1)));
+            std::ranges::copy(begin(), end(), larger.data() + new_first);
+            heap_values = std::move(larger);
+        }
+        else if (new_first < first)
+        {
+            std::ranges::copy(begin(), end(), data() + new_first);
+        }
+        else
+        {
+            std::ranges::copy_backward(begin(), end(), data() + new_first + count);
+        }
+
+        first = new_first;
+        last = new_first + count;
+    }
+
+    //!\brief Copies the window of `other` to the same indices, keeping a heap buffer of this object if it fits.
+    void assign(window_buffer const & other)
+    {
+        if (other.heap_values.empty())
+            heap_values.clear();
+        else if (heap_values.size() != other.heap_values.size())
+            heap_values.assign(other.heap_values.size(), value_t{});
+
+        first = other.first;
+        last = other.last;
+        std::ranges::copy(other.begin(), other.end(), begin());
+    }
+
+    //!\brief Takes the heap buffer of `other`, or copies its window if it is stored inline.
+    void assign(window_buffer && other) noexcept(std::is_nothrow_copy_assignable_v<value_t>)
+    {
+        if (other.heap_values.empty())
+        {
+            heap_values.clear();
+            first = other.first;
+            last = other.last;
+            std::ranges::copy(other.begin(), other.end(), begin());
+        }
+        else
+        {
+            heap_values = std::move(other.heap_values);
+            first = other.first;
+            last = other.last;
+            other.first = other.last = other.capacity() / 2;
+        }
+    }
+};
+} // namespace seqan3::detail
@@ -0,0 +1,277 @@
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include <seqan3/alphabet/nucleotide/dna4.hpp>
+#include <seqan3/argument_parser/all.hpp>
+#include <seqan3/search/views/mapped_sequence_file.hpp>
+#include <seqan3/search/views/minhash_sketch.hpp>
+#include <seqan3/search/views/minimiser_hash.hpp>
+#include <seqan3/search/views/modmer_hash.hpp>
+#include <seqan3/search/views/opensyncmer_hash.hpp>
+#include <seqan3/search/views/profiler.hpp>
+#include <seqan3/search/views/record_pipeline.hpp>
+#include <seqan3/search/views/sketch_file.hpp>
+#include <seqan3/search/views/syncmer_hash.hpp>
+
+/* Writes the hashes of every record of FASTA or FASTQ files to a binary sketch file (see include/sketch_file.hpp).
+ *
+ * Every record becomes one sketch named after its id. For minimiser, kmer is the window size and smer the shape size;
+ * for modmer, kmer is the k-mer size and smer the mod. With --bottom or --scale, every sketch is reduced to a
+ * seqan3::bottom_sketch or seqan3::scaled_sketch of the sampled hashes.
+ *
+ * With --profile, the time of the stages parse, rank (conversion of the characters to seqan3::dna4), sample (k-mer
+ * hashing and the sampling view) and index (reduction and writing) is written as JSON, see seqan3::profiler. The
+ * output of every stage is then stored before the next one starts, so that the stages can be timed separately.
+ * --trace writes every call in the Chrome trace event format.
+ *
+ * Uncompressed files are memory-mapped; gzip and BGZF files are inflated by a seqan3::record_pipeline on background
+ * threads, --threads of them for BGZF.
+ */
+
+struct sketch_arguments
+{
+    std::string method{"syncmer"};
+    size_t kmer{};
+    size_t smer{};
+    std::vector<std::filesystem::path> inputs{};
+    std::filesystem::path output{};
+    uint32_t sketch_size{};
+    uint64_t scale{};
+    size_t threads{1};
+    std::filesystem::path profile{};
+    std::filesystem::path trace{};
+};
+
+seqan3::sketch_parameters parameters_of(sketch_arguments const & args)
+{
+    seqan3::sketch_parameters parameters{};
+    parameters.kmer = args.kmer;
+    parameters.smer = args.smer;
+    parameters.sketch_size = args.sketch_size;
+    parameters.scale = args.scale;
+
+    if (args.method == "syncmer")
+        parameters.scheme = seqan3::sketch_scheme::syncmer;
+    else if (args.method == "opensyncmer")
+        parameters.scheme = seqan3::sketch_scheme::opensyncmer;
+    else if (args.method == "minimiser")
+    {
+        parameters.scheme = seqan3::sketch_scheme::minimiser;
+        parameters.window = args.kmer;
+    }
+    else
+        parameters.scheme = seqan3::sketch_scheme::modmer;
+
+    return parameters;
+}
+
+// Adds the hashes of one record, reduced to a bottom or scaled sketch if requested.
+template <typename hashes_t>
+void add_hashes(seqan3::sketch_writer & writer, sketch_arguments const & args, std::string_view const name,
+                hashes_t && hashes)
+{
+    if (args.sketch_size != 0)
+    {
+        seqan3::bottom_sketch sketch{args.sketch_size};
+        sketch.insert(hashes);
+        writer.add(name, sketch.hashes());
+    }
+    else if (args.scale != 0)
+    {
+        seqan3::scaled_sketch sketch{args.scale};
+        sketch.insert(hashes);
+        writer.add(name, sketch.hashes());
+    }
+    else
+    {
+        writer.add(name, hashes);
+    }
+}
+
+// Calls `callback` with the hashes of the method on a sequence; sequences shorter than a k-mer have none.
+template <typename sequence_t, typename callback_t>
+void with_hashes(sketch_arguments const & args, sequence_t && sequence, callback_t && callback)
+{
+    if (static_cast<size_t>(std::ranges::distance(sequence)) < args.kmer)
+        callback(std::views::empty<uint64_t>);
+    else if (args.method == "syncmer")
+        callback(sequence | syncmer_hash(args.smer, args.kmer));
+    else if (args.method == "opensyncmer")
+        callback(sequence | opensyncmer_hash(args.smer, args.kmer));
+    else if (args.method == "minimiser")
+        callback(sequence | seqan3::views::minimiser_hash(
+                                seqan3::shape{seqan3::ungapped{static_cast<uint8_t>(args.smer)}},
+                                seqan3::window_size{static_cast<uint32_t>(args.kmer)}));
+    else
+        callback(sequence | modmer_hash(seqan3::shape{seqan3::ungapped{static_cast<uint8_t>(args.kmer)}}, args.smer));
+}
+
+// Adds the sketch of one record.
+template <typename sequence_t>
+void add_sketch(seqan3::sketch_writer & writer, sketch_arguments const & args, std::string_view const name,
+                sequence_t && sequence)
+{
+    with_hashes(args, sequence, [&] (auto && hashes) { add_hashes(writer, args, name, hashes); });
+}
+
+// Adds the sketch of one record and times the stages separately.
+template <typename sequence_t>
+void add_sketch_profiled(seqan3::sketch_writer & writer, sketch_arguments const & args, std::string_view const name,
+                         sequence_t && sequence)
+{
+    static size_t const rank_stage = seqan3::profiler::global().stage("rank");
+    static size_t const sample_stage = seqan3::profiler::global().stage("sample");
+    static size_t const index_stage = seqan3::profiler::global().stage("index");
+
+    std::vector<seqan3::dna4> ranks{};
+    {
+        seqan3::scoped_timer timer{rank_stage};
+        for (seqan3::dna4 const base : sequence)
+            ranks.push_back(base);
+        timer.add_items(ranks.size());
+    }
+
+    std::vector<uint64_t> hashes{};
+    {
+        seqan3::scoped_timer timer{sample_stage, ranks.size()};
+        with_hashes(args, ranks, [&hashes] (auto && sampled)
+        {
+            for (uint64_t const hash : sampled)
+                hashes.push_back(hash);
+        });
+    }
+
+    seqan3::scoped_timer timer{index_stage, hashes.size()};
+    add_hashes(writer, args, name, hashes);
+}
+
+// Calls `callback` with every record of a file in file order.
+template <typename callback_t>
+void for_each_record(sketch_arguments const & args, std::filesystem::path const & path, callback_t && callback)
+{
+    if (seqan3::record_pipeline<seqan3::dna4>::is_compressed(path))
+    {
+        // A single parsing thread keeps the records, and so the sketches, in file order.
+        seqan3::record_pipeline<seqan3::dna4> pipeline{path, 1, args.threads};
+        pipeline.run([&callback] (auto const & record, size_t) { callback(record); });
+    }
+    else
+    {
+        for (auto const & record : seqan3::mapped_sequence_file<seqan3::dna4>{path})
+            callback(record);
+    }
+}
+
+void run_program(sketch_arguments const & args)
+{
+    seqan3::profiler & profiler = seqan3::profiler::global();
+    if (!args.profile.empty() || !args.trace.empty())
+        profiler.enable(!args.trace.empty());
+    size_t const parse_stage = profiler.stage("parse");
+
+    seqan3::sketch_writer writer{args.output, parameters_of(args)};
+
+    for (auto const & path : args.inputs)
+    {
+        // Parsing happens when the file iterator advances, so it is timed between the records.
+        uint64_t parse_begin = seqan3::detail::read_cycles();
+        for_each_record(args, path, [&] (auto const & record)
+        {
+            if (profiler.enabled())
+            {
+                profiler.record(parse_stage, parse_begin, seqan3::detail::read_cycles(), 1);
+                add_sketch_profiled(writer, args, record.id, record.sequence());
+                parse_begin = seqan3::detail::read_cycles();
+            }
+            else
+            {
+                add_sketch(writer, args, record.id, record.sequence());
+            }
+        });
+    }
+
+    writer.finish();
+
+    if (!args.profile.empty())
+    {
+        std::ofstream profile{args.profile};
+        profiler.write_json(profile);
+    }
+    if (!args.trace.empty())
+    {
+        std::ofstream trace{args.trace};
+        profiler.write_chrome_trace(trace);
+    }
+}
+
+void initialise_argument_parser(seqan3::argument_parser & parser, sketch_arguments & args)
+{
+    parser.info.short_description = "Writes the hashes of every sequence to a binary sketch file.";
+
+    parser.add_option(args.method, 'm', "method", "The sampling method.", seqan3::option_spec::standard,
+                      seqan3::value_list_validator{"syncmer", "opensyncmer", "minimiser", "modmer"});
+    parser.add_option(args.kmer, 'k', "kmer", "The k-mer size, or the window size for minimiser.",
+                      seqan3::option_spec::required, seqan3::arithmetic_range_validator{1, 32});
+    parser.add_option(args.smer, 's', "smer", "The s-mer size, or the mod for modmer.",
+                      seqan3::option_spec::required, seqan3::arithmetic_range_validator{1, 1024});
+    parser.add_option(args.inputs, 'i', "input", "A FASTA or FASTQ file, optionally gzip or BGZF compressed, repeat "
+                      "the option for several files.",
+                      seqan3::option_spec::required, seqan3::input_file_validator{});
+    parser.add_option(args.output, 'o', "output", "The sketch file to write.", seqan3::option_spec::required);
+    parser.add_option(args.sketch_size, 'b', "bottom", "Keep the given number of smallest mixed hashes per sketch.",
+                      seqan3::option_spec::standard);
+    parser.add_option(args.scale, 'c', "scale", "Keep the mixed hashes up to 2^64 / scale (FracMinHash).",
+                      seqan3::option_spec::standard);
+    parser.add_option(args.threads, 'j', "threads", "The number of threads inflating BGZF input.",
+                      seqan3::option_spec::standard, seqan3::arithmetic_range_validator{1, 1024});
+    parser.add_option(args.profile, 'p', "profile", "Write the time per stage as JSON to the given file.",
+                      seqan3::option_spec::standard);
+    parser.add_option(args.trace, 'e', "trace", "Write a Chrome trace of all timed calls to the given file.",
+                      seqan3::option_spec::standard);
+}
+
+int main(int argc, char ** argv)
+{
+    seqan3::argument_parser parser{"sketch", argc, argv};
+    sketch_arguments args{};
+    initialise_argument_parser(parser, args);
+
+    try
+    {
+        parser.parse();
+
+        if (args.method != "modmer" && args.smer >= args.kmer)
+            throw seqan3::argument_parser_error{"Please choose an s-mer size smaller than the k-mer size."};
+
+        if (args.sketch_size != 0 && args.scale != 0)
+            throw seqan3::argument_parser_error{"Please choose either --bottom or --scale."};
+    }
+    catch (seqan3::argument_parser_error const & ext)
+    {
+        std::cerr << "[Error] " << ext.what() << '\n';
+        return -1;
+    }
+
+    try
+    {
+        run_program(args);
+    }
+    catch (seqan3::file_open_error const & ext)
+    {
+        std::cerr << "[Error] " << ext.what() << '\n';
+        return -1;
+    }
+    catch (seqan3::format_error const & ext) // A malformed or corrupt (compressed) input file.
+    {
+        std::cerr << "[Error] " << ext.what() << '\n';
+        return -1;
+    }
+    catch (std::invalid_argument const & ext) // Parameters the sampling view rejects.
+    {
+        std::cerr << "[Error] " << ext.what() << '\n';
+        return -1;
+    }
+
+    return 0;
+}
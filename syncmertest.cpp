@@ -5,10 +5,27 @@
 #include <seqan3/search/views/opensyncmer_hash.hpp>
 #include <seqan3/search/views/syncmer_hash.hpp>
 #include <seqan3/search/views/minimiser_hash.hpp>
+#include <seqan3/search/views/modmer_hash.hpp>
+#include <seqan3/search/views/mapped_sequence_file.hpp>
 using namespace seqan3::literals;
 
-int main()
+int main(int argc, char ** argv)
 {
+    // With a FASTA or FASTQ file, print the number of syncmers of every record instead.
+    if (argc > 1)
+    {
+        seqan3::mapped_sequence_file file{argv[1]};
+        for (auto const & record : file)
+        {
+            size_t count{0};
+            if (std::ranges::distance(record.sequence()) >= 5)
+                for ([[maybe_unused]] uint64_t const hash : record.sequence() | syncmer_hash(2, 5, seqan3::seed{0}))
+                    ++count;
+            seqan3::debug_stream << record.id << ": " << count << " syncmers\n";
+        }
+        return 0;
+    }
+
     seqan3::seed seed = seqan3::seed{0};
     std::vector<seqan3::dna4> text{"ACGGCGACGTTTAG"_dna4};
     auto text_reversed = text
@@ -66,6 +83,9 @@ int main()
 
    auto opensyncmer_forward = text | opensyncmer_hash(2, 5, seqan3::seed{0});
    auto syncmer_forward = text | syncmer_hash(2, 5, seqan3::seed{0});
+   auto modmer_forward = text | modmer_hash(seqan3::shape(seqan3::ungapped(5)), 3, seqan3::seed{0});
+   auto scaled_syncmer_forward = text | scaled_syncmer_hash(2, 5, 2, seqan3::seed{0});
+   auto middle_syncmer_forward = text | offset_syncmer_hash<seqan3::middle_syncmer_offsets>(2, 5, seqan3::seed{0});
 
    auto opensyncmer_reverse = text_reversed | opensyncmer_hash(2, 5, seqan3::seed{0});
    auto syncmer_reverse = text_reversed | syncmer_hash(2, 5, seqan3::seed{0});
@@ -82,6 +102,9 @@ int main()
 
    seqan3::debug_stream << "opensyncmer_forward: " << opensyncmer_forward << '\n';
    seqan3::debug_stream << "syncmer_forward: " << syncmer_forward << '\n';
+   seqan3::debug_stream << "middle_syncmer_forward: " << middle_syncmer_forward << '\n';
+   seqan3::debug_stream << "modmer_forward: " << modmer_forward << '\n';
+   seqan3::debug_stream << "scaled_syncmer_forward: " << scaled_syncmer_forward << '\n';
    
    seqan3::debug_stream << "opensyncmer_reverse: " << opensyncmer_reverse << '\n';
    seqan3::debug_stream << "syncmer_reverse: " << syncmer_reverse << '\n';